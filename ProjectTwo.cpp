@@ -4,14 +4,31 @@
 // and shows details (title + prerequisites) for a requested course.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
 // ----------------------------- Utilities -------------------------------------
 // Trim leading/trailing spaces and CR/LF
 static inline std::string trim(std::string s) {
@@ -23,21 +40,259 @@ static inline std::string trim(std::string s) {
     return s;
 }
 
+// ASCII case folding, 8 bytes per step (SWAR). Only 'a'..'z' change; bytes
+// >= 0x80 are passed through untouched, which matches std::toupper in the
+// default "C" locale and keeps UTF-8 sequences intact.
+static inline std::uint64_t fold_upper8(std::uint64_t w) {
+    const std::uint64_t ones = 0x0101010101010101ULL;
+    const std::uint64_t high = 0x8080808080808080ULL;
+    std::uint64_t x = w & ~high;                 // low 7 bits of each byte
+    std::uint64_t ge_a = x + ones * (0x80 - 'a'); // high bit set where x >= 'a'
+    std::uint64_t gt_z = x + ones * (0x7F - 'z'); // high bit set where x > 'z'
+    std::uint64_t lower = ge_a & ~gt_z & ~w & high;
+    return w ^ (lower >> 2);                      // clear 0x20 on lowercase letters
+}
+
+// Loads up to 8 bytes at p (zero padded) and case-folds them.
+static inline std::uint64_t load_folded8(const char* p, size_t n) {
+    std::uint64_t w = 0;
+    std::memcpy(&w, p, n < 8 ? n : 8);
+    return fold_upper8(w);
+}
+
 // Uppercase copy (for normalizing course numbers)
 static inline std::string upper(std::string s) {
-    for (char& c : s) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    size_t i = 0;
+    for (; i + 8 <= s.size(); i += 8) {
+        std::uint64_t w = load_folded8(&s[i], 8);
+        std::memcpy(&s[i], &w, 8);
+    }
+    if (i < s.size()) {
+        std::uint64_t w = load_folded8(&s[i], s.size() - i);
+        std::memcpy(&s[i], &w, s.size() - i);
+    }
     return s;
 }
 
-// Split a CSV line on commas (no quoted fields in this assignment dataset)
-static std::vector<std::string> split_csv_simple(const std::string& line) {
-    std::vector<std::string> parts;
-    std::stringstream ss(line);
-    std::string item;
-    while (std::getline(ss, item, ',')) {
-        parts.push_back(trim(item));
+// Case-insensitive hash/equality for course numbers, so lookups with input
+// like "csci200" hit the uppercase keys without building a normalized copy.
+struct CourseKeyHash {
+    size_t operator()(std::string_view s) const {
+        std::uint64_t h = 0xcbf29ce484222325ULL ^ s.size();
+        for (size_t i = 0; i < s.size(); i += 8) {
+            h ^= load_folded8(s.data() + i, s.size() - i);
+            h *= 0x100000001b3ULL;
+            h ^= h >> 29;
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+struct CourseKeyEq {
+    bool operator()(std::string_view a, std::string_view b) const {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i += 8) {
+            if (load_folded8(a.data() + i, a.size() - i) != load_folded8(b.data() + i, b.size() - i)) return false;
+        }
+        return true;
+    }
+};
+
+// Splits [0, n) into one contiguous chunk per hardware thread and runs
+// fn(begin, end, chunk) on each, returning once all chunks finish.
+// Returns the number of chunks used (at least 1; small inputs stay on one thread).
+template <typename Fn>
+static size_t for_each_chunk(size_t n, Fn fn, size_t min_chunk = 4096) {
+    size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threads = std::max<size_t>(1, std::min(threads, n / min_chunk));
+    size_t step = (n + threads - 1) / threads;
+    if (threads == 1) {
+        fn(size_t(0), n, size_t(0));
+        return 1;
+    }
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; ++t) {
+        size_t b = std::min(n, t * step), e = std::min(n, b + step);
+        workers.emplace_back([=, &fn] { fn(b, e, t); });
+    }
+    fn(size_t(0), std::min(n, step), size_t(0));
+    for (std::thread& w : workers) w.join();
+    return threads;
+}
+
+// ---------------------------- Slow-query log ---------------------------------
+// Keeps the last kSlowLogSize operations that took longer than kSlowOpThresholdMs.
+// A fast operation only pays two clock reads and a compare; slow ones are
+// formatted into a fixed slot so the log can be dumped from a signal handler.
+constexpr double kSlowOpThresholdMs = 100.0;
+constexpr size_t kSlowLogSize = 64;
+constexpr size_t kMaxPhases = 8;  // the longest operation (diff) records five
+
+struct SlowLogSlot {
+    std::atomic<bool> ready{false};
+    int length = 0;
+    char text[256];
+};
+
+static SlowLogSlot g_slow_log[kSlowLogSize];
+static std::atomic<std::uint64_t> g_slow_log_next{0};
+
+// Writes every recorded slot to stderr. Only uses write(), so it is safe to
+// call from the SIGUSR1 handler as well as at exit.
+static void dump_slow_log() {
+    std::uint64_t end = g_slow_log_next.load(std::memory_order_acquire);
+    std::uint64_t begin = (end > kSlowLogSize) ? end - kSlowLogSize : 0;
+    for (std::uint64_t i = begin; i < end; ++i) {
+        const SlowLogSlot& slot = g_slow_log[i % kSlowLogSize];
+        if (!slot.ready.load(std::memory_order_acquire)) continue;
+#if defined(__unix__) || defined(__APPLE__)
+        ssize_t ignored = write(STDERR_FILENO, slot.text, static_cast<size_t>(slot.length));
+        (void)ignored;
+#else
+        std::fwrite(slot.text, 1, static_cast<size_t>(slot.length), stderr);
+#endif
+    }
+}
+
+static void on_dump_signal(int) { dump_slow_log(); }
+
+// Times one REPL operation and its phases; records it on destruction if slow.
+class OpTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    OpTimer(const char* op, std::string key, std::uint64_t catalog_version)
+        : op_(op), key_(std::move(key)), version_(catalog_version), start_(Clock::now()), mark_(start_) {}
+
+    // Ends the current phase under the given name.
+    void phase(const char* name) {
+        Clock::time_point now = Clock::now();
+        if (phase_count_ < kMaxPhases) {
+            phase_names_[phase_count_] = name;
+            phase_ms_[phase_count_] = ms_between(mark_, now);
+            ++phase_count_;
+        } else {
+            ++dropped_phases_;
+        }
+        mark_ = now;
+    }
+
+    ~OpTimer() {
+        double total = ms_between(start_, Clock::now());
+        if (total < kSlowOpThresholdMs) return;
+
+        SlowLogSlot& slot = g_slow_log[g_slow_log_next.fetch_add(1, std::memory_order_acq_rel) % kSlowLogSize];
+        slot.ready.store(false, std::memory_order_release);
+        int n = std::snprintf(slot.text, sizeof(slot.text), "[slow] %s key=\"%.32s\" %.1f ms catalog_v%llu",
+                              op_, key_.c_str(), total, static_cast<unsigned long long>(version_));
+        for (size_t i = 0; i < phase_count_ && n > 0 && n < static_cast<int>(sizeof(slot.text)); ++i) {
+            n += std::snprintf(slot.text + n, sizeof(slot.text) - n, " %s=%.1f", phase_names_[i], phase_ms_[i]);
+        }
+        if (dropped_phases_ && n > 0 && n < static_cast<int>(sizeof(slot.text))) {
+            n += std::snprintf(slot.text + n, sizeof(slot.text) - n, " (+%zu phases truncated)", dropped_phases_);
+        }
+        if (n < 0) n = 0;
+        if (n > static_cast<int>(sizeof(slot.text)) - 2) n = static_cast<int>(sizeof(slot.text)) - 2;
+        slot.text[n++] = '\n';
+        slot.length = n;
+        slot.ready.store(true, std::memory_order_release);
+    }
+
+private:
+    static double ms_between(Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    }
+
+    const char* op_;
+    std::string key_;
+    std::uint64_t version_;
+    Clock::time_point start_;
+    Clock::time_point mark_;
+    const char* phase_names_[kMaxPhases] = {};
+    double phase_ms_[kMaxPhases] = {};
+    size_t phase_count_ = 0;
+    size_t dropped_phases_ = 0;
+};
+
+// ----------------------------- Tokenizing ------------------------------------
+// Start/end offsets of one field inside the raw file buffer.
+struct FieldSpan {
+    std::uint32_t begin;
+    std::uint32_t end;
+};
+
+// Parse-once intermediate for loading: the raw file plus a flat array of
+// trimmed field offsets (no quoted fields in this assignment dataset).
+// Every load stage walks these rows instead of re-splitting lines into strings.
+struct TokenizedCsv {
+    std::string buf;                      // raw file contents
+    std::vector<FieldSpan> fields;        // every field, row after row
+    std::vector<std::uint32_t> row_first; // index of each row's first field (+1 sentinel)
+    std::vector<std::uint32_t> row_line;  // 1-based source line of each row
+
+    size_t rows() const { return row_line.size(); }
+    size_t field_count(size_t row) const { return row_first[row + 1] - row_first[row]; }
+    std::string_view field(size_t row, size_t i) const {
+        const FieldSpan& f = fields[row_first[row] + i];
+        return std::string_view(buf.data() + f.begin, f.end - f.begin);
+    }
+};
+
+// Records field offsets for each non-blank line already in out.buf;
+// line numbers count from first_line.
+static void tokenize_buffer(TokenizedCsv& out, std::uint32_t first_line = 1) {
+    auto is_space = [](char ch) { return std::isspace(static_cast<unsigned char>(ch)) != 0; };
+    const std::string& b = out.buf;
+    std::uint32_t pos = 0, line_no = first_line - 1;
+    const std::uint32_t size = static_cast<std::uint32_t>(b.size());
+
+    out.row_first.push_back(0);
+    while (pos < size) {
+        std::uint32_t eol = pos;
+        while (eol < size && b[eol] != '\n') ++eol;
+        ++line_no;
+
+        // Trim the line, then skip it if nothing is left
+        std::uint32_t lb = pos, le = eol;
+        pos = eol + 1;
+        while (lb < le && is_space(b[lb])) ++lb;
+        while (le > lb && is_space(b[le - 1])) --le;
+        if (lb == le) continue;
+
+        // Split on commas; a trailing comma does not start another field
+        std::uint32_t fb = lb;
+        while (true) {
+            std::uint32_t fe = fb;
+            while (fe < le && b[fe] != ',') ++fe;
+            std::uint32_t tb = fb, te = fe;
+            while (tb < te && is_space(b[tb])) ++tb;
+            while (te > tb && is_space(b[te - 1])) --te;
+            out.fields.push_back({tb, te});
+            if (fe >= le || fe + 1 == le) break;
+            fb = fe + 1;
+        }
+        out.row_first.push_back(static_cast<std::uint32_t>(out.fields.size()));
+        out.row_line.push_back(line_no);
+    }
+}
+
+// Reads the whole file and records field offsets for each non-blank line.
+// Returns true on success; false with error message on failure.
+bool tokenize_csv(const std::string& file_path, TokenizedCsv& out, std::string& err) {
+    std::ifstream fin(file_path, std::ios::binary);
+    if (!fin) {
+        err = "Could not open file: " + file_path;
+        return false;
+    }
+    std::ostringstream raw;
+    raw << fin.rdbuf();
+    out.buf = raw.str();
+    if (out.buf.size() > UINT32_MAX) {
+        err = "File too large: " + file_path;
+        return false;
     }
-    return parts;
+    tokenize_buffer(out);
+    return true;
 }
 
 // ----------------------------- Data Model ------------------------------------
@@ -47,87 +302,2297 @@ struct Course {
     std::string title;                  // e.g., "Data Structures"
     std::vector<std::string> prereqs;   // e.g., {"CSCI101"}
 
+    // Optional typed columns (only filled when the file has a header row); 0 = not given
+    std::uint8_t credits = 0;           // e.g., 3
+    std::uint16_t level = 0;            // e.g., 300
+    std::uint8_t terms = 0;             // bitmask of TermBit values
+    std::uint16_t capacity = 0;         // e.g., 30
+
     Course() = default;
     Course(std::string num, std::string name) : number(std::move(num)), title(std::move(name)) {}
 };
 
-// In-memory catalog using an unordered_map for O(1) lookups by course number.
+// Bits for Course::terms
+enum TermBit : std::uint8_t { kFall = 1, kSpring = 2, kSummer = 4, kWinter = 8 };
+
+// One scheduled offering of a course, loaded from the optional sections file.
+struct Section {
+    std::string key;            // e.g., "CSCI200-01" (course number + section id)
+    std::uint32_t course = 0;   // catalog id of the course
+    std::uint8_t terms = 0;     // TermBit flags
+    std::uint8_t days = 0;      // bit 0 = Monday ... bit 6 = Sunday
+    std::uint16_t start = 0;    // minutes after midnight
+    std::uint16_t end = 0;      // minutes after midnight, > start
+    std::uint16_t seats = 0;
+};
+
+// Seat counters, holders and waitlists for every section.
+// Each section keeps its taken count and waitlist length in one atomic word,
+// and every claim or release decides its outcome with a single CAS on that
+// word: take a seat, join the waitlist, free a seat, or pass a seat to the
+// waitlist. That CAS is the linearization point, so a claim can never see a
+// section full while a release frees a seat with nobody left waiting.
+// Who holds what is tracked per (section, student) pair in a hopscotch
+// table: a pair lives within kHop slots of its home, and the home keeps a
+// bitmap of those slots plus a version in one atomic word. A new pair takes
+// a free slot by CAS and is published by a CAS on the home word, which fails
+// if the home changed since the lookup, so the same student cannot claim a
+// section twice; pairs leave the table when released, so slots are reused
+// and the table only needs room for the seats and waitlists. The waitlist
+// order lives in a lock-free FIFO (Vyukov's MPMC ring) that is filled and
+// drained right after the word CAS that reserved or consumed a place.
+class SeatLedger {
+public:
+    enum class Claim { Reserved, Waitlisted, Full, AlreadyListed, Untracked };
+    enum class Release { Freed, PassedOn, NotHolding };
+    static constexpr size_t kWaitlistSize = 16;
+
+    // Starts every section empty. The pair table is sized for every seat and
+    // waitlist place at a quarter load, plus room for claims in flight.
+    void reset(const std::vector<Section>& sections) {
+        count_ = sections.size();
+        capacity_.resize(count_);
+        state_ = std::make_unique<std::atomic<std::uint64_t>[]>(count_);
+        waitlists_ = std::make_unique<Waitlist[]>(count_);
+        for (size_t i = 0; i < count_; ++i) {
+            capacity_[i] = sections[i].seats;
+            state_[i].store(0, std::memory_order_relaxed);
+            for (size_t k = 0; k < kRingSize; ++k) waitlists_[i].slots[k].seq.store(k, std::memory_order_relaxed);
+        }
+        size_t places = count_ * kWaitlistSize;
+        for (const Section& sec : sections) places += sec.seats;
+        pair_slots_ = 2 * kHop;
+        while (pair_slots_ < 4 * places + 1024) pair_slots_ <<= 1;
+        homes_ = std::make_unique<std::atomic<std::uint64_t>[]>(pair_slots_);
+        pairs_ = std::make_unique<std::atomic<std::uint64_t>[]>(pair_slots_);
+        for (size_t i = 0; i < pair_slots_; ++i) {
+            homes_[i].store(0, std::memory_order_relaxed);
+            pairs_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Takes a seat if one is free, else joins the waitlist if it has room.
+    // A student who already holds a seat or a waitlist place gets AlreadyListed.
+    // Untracked means no pair slot was free near the student's home slot;
+    // the sizing in reset makes that rare, and a retry may succeed.
+    Claim claim(size_t section, std::uint32_t student) {
+        const std::uint64_t key = pair_key(section, student);
+        size_t slot = 0;
+        Claim refused;
+        if (!insert_pair(key, slot, refused)) return refused;
+
+        std::uint64_t word = state_[section].load(std::memory_order_acquire);
+        for (;;) {
+            std::uint64_t next;
+            Claim outcome;
+            if (taken_of(word) < capacity_[section]) {
+                next = word + 1;
+                outcome = Claim::Reserved;
+            } else if (waiting_of(word) < kWaitlistSize) {
+                next = word + kWaitingOne;
+                outcome = Claim::Waitlisted;
+            } else {
+                erase_pair(key, slot);
+                return Claim::Full;
+            }
+            if (!state_[section].compare_exchange_weak(word, next, std::memory_order_acq_rel)) continue;
+            if (outcome == Claim::Reserved) {
+                pairs_[slot].store(key | kHolding, std::memory_order_release);
+            } else {
+                pairs_[slot].store(key | kWaiting, std::memory_order_release);
+                push_waitlist(waitlists_[section], student);
+            }
+            return outcome;
+        }
+    }
+
+    // Gives up the student's seat. If anyone is waitlisted the seat passes
+    // to the head of the waitlist (returned through promoted) and the taken
+    // count is unchanged. Students holding no seat get NotHolding.
+    Release release(size_t section, std::uint32_t student, std::uint32_t& promoted) {
+        const std::uint64_t key = pair_key(section, student);
+        size_t slot = 0;
+        std::uint64_t expected = key | kHolding;
+        if (find_pair(key, slot) != expected ||
+            !pairs_[slot].compare_exchange_strong(expected, key | kReleasing, std::memory_order_acq_rel)) {
+            return Release::NotHolding;
+        }
+
+        std::uint64_t word = state_[section].load(std::memory_order_acquire);
+        bool pass_on;
+        for (;;) {
+            pass_on = waiting_of(word) > 0;
+            std::uint64_t next = pass_on ? word - kWaitingOne : word - 1;
+            if (state_[section].compare_exchange_weak(word, next, std::memory_order_acq_rel)) break;
+        }
+        if (pass_on) {
+            promoted = pop_waitlist(waitlists_[section]);
+            const std::uint64_t next_key = pair_key(section, promoted);
+            size_t next_slot = 0;
+            find_pair(next_key, next_slot);  // present and waiting: only this release can move it
+            pairs_[next_slot].store(next_key | kHolding, std::memory_order_release);
+        }
+        erase_pair(key, slot);
+        return pass_on ? Release::PassedOn : Release::Freed;
+    }
+
+    std::uint32_t taken(size_t section) const { return taken_of(state_[section].load(std::memory_order_acquire)); }
+    std::uint32_t waiting(size_t section) const { return waiting_of(state_[section].load(std::memory_order_acquire)); }
+    std::uint32_t capacity(size_t section) const { return capacity_[section]; }
+    size_t size() const { return count_; }
+
+    // Cross-checks counters against the pair table once no calls are in
+    // flight: taken never exceeds seats and matches the holders, the
+    // waitlist length matches the waiting students, and nobody waits while
+    // a seat is free. Returns false with err describing the first mismatch.
+    bool check_quiescent(std::string& err) const {
+        std::vector<std::uint32_t> holders(count_), waiters(count_);
+        for (size_t i = 0; i < pair_slots_; ++i) {
+            std::uint64_t word = pairs_[i].load(std::memory_order_acquire);
+            if (!word) continue;
+            size_t section = static_cast<size_t>((word >> 35) - 1);
+            std::uint64_t state = word & kStateMask;
+            if (state == kHolding) ++holders[section];
+            else if (state == kWaiting) ++waiters[section];
+            else {
+                err = "section " + std::to_string(section) + " has a claim or release still in progress";
+                return false;
+            }
+        }
+        for (size_t s = 0; s < count_; ++s) {
+            std::uint32_t t = taken(s), w = waiting(s);
+            const Waitlist& q = waitlists_[s];
+            std::uint64_t queued = q.tail.load(std::memory_order_acquire) - q.head.load(std::memory_order_acquire);
+            if (t > capacity_[s] || t != holders[s] || w != waiters[s] || w != queued || (w && t < capacity_[s])) {
+                err = "section " + std::to_string(s) + ": taken " + std::to_string(t) + "/" +
+                      std::to_string(capacity_[s]) + ", holders " + std::to_string(holders[s]) + ", waiting " +
+                      std::to_string(w) + ", waitlisted students " + std::to_string(waiters[s]) + ", queued " +
+                      std::to_string(queued);
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    // Pair word: (section + 1) << 35 | student << 3 | state; 0 = free slot
+    static constexpr std::uint64_t kClaiming = 1, kHolding = 2, kWaiting = 3, kReleasing = 4, kStateMask = 7;
+    // Home word: version in the high 32 bits, bitmap of the home's pair slots in the low kHop
+    static constexpr size_t kHop = 32;
+    static constexpr std::uint64_t kVersionOne = std::uint64_t(1) << 32;
+    // Section word: taken count in the low 32 bits, waitlist length in the high 32
+    static constexpr std::uint64_t kWaitingOne = std::uint64_t(1) << 32;
+    // The ring is twice the waitlist so a claim can enqueue while a release
+    // that already consumed a place has not dequeued yet
+    static constexpr size_t kRingSize = 2 * kWaitlistSize;
+
+    static std::uint32_t taken_of(std::uint64_t word) { return static_cast<std::uint32_t>(word); }
+    static std::uint32_t waiting_of(std::uint64_t word) { return static_cast<std::uint32_t>(word >> 32); }
+    static std::uint64_t pair_key(size_t section, std::uint32_t student) {
+        return (static_cast<std::uint64_t>(section) + 1) << 35 | static_cast<std::uint64_t>(student) << 3;
+    }
+    size_t home_of(std::uint64_t key) const {
+        std::uint64_t h = key * 0x9e3779b97f4a7c15ULL;
+        return static_cast<size_t>(h ^ (h >> 32)) & (pair_slots_ - 1);
+    }
+
+    struct Slot {
+        std::atomic<std::uint64_t> seq{0};
+        std::uint32_t student = 0;
+    };
+    struct Waitlist {
+        alignas(64) std::atomic<std::uint64_t> head{0};
+        alignas(64) std::atomic<std::uint64_t> tail{0};
+        Slot slots[kRingSize];
+    };
+
+    // Current pair word for key (0 if absent); slot receives its position.
+    // A slot named in the home bitmap is never 0 (insert fills the slot
+    // before publishing the bit, erase clears the bit before the slot).
+    std::uint64_t find_pair(std::uint64_t key, size_t& slot) const {
+        const size_t home = home_of(key);
+        const std::uint64_t bits = homes_[home].load(std::memory_order_acquire);
+        for (size_t d = 0; d < kHop; ++d) {
+            if (!(bits >> d & 1)) continue;
+            size_t at = (home + d) & (pair_slots_ - 1);
+            std::uint64_t word = pairs_[at].load(std::memory_order_acquire);
+            if ((word & ~kStateMask) == key) {
+                slot = at;
+                return word;
+            }
+        }
+        return 0;
+    }
+
+    // Adds key in the claiming state. The home word CAS only succeeds if no
+    // pair of this home was added or removed since the lookup, so two claims
+    // by one student cannot both insert. On failure refused says why.
+    bool insert_pair(std::uint64_t key, size_t& slot, Claim& refused) {
+        const size_t home = home_of(key);
+        for (;;) {
+            std::uint64_t home_word = homes_[home].load(std::memory_order_acquire);
+            size_t found = 0;
+            if (find_pair(key, found) != 0) {
+                refused = Claim::AlreadyListed;
+                return false;
+            }
+            size_t offset = kHop;
+            for (size_t d = 0; d < kHop && offset == kHop; ++d) {
+                size_t at = (home + d) & (pair_slots_ - 1);
+                std::uint64_t empty = 0;
+                if (pairs_[at].load(std::memory_order_relaxed) == 0 &&
+                    pairs_[at].compare_exchange_strong(empty, key | kClaiming, std::memory_order_acq_rel)) {
+                    offset = d;
+                }
+            }
+            if (offset == kHop) {
+                refused = Claim::Untracked;
+                return false;
+            }
+            slot = (home + offset) & (pair_slots_ - 1);
+            std::uint64_t published = (home_word + kVersionOne) | (std::uint64_t(1) << offset);
+            if (homes_[home].compare_exchange_strong(home_word, published, std::memory_order_acq_rel)) return true;
+            pairs_[slot].store(0, std::memory_order_release);  // home changed; look again
+        }
+    }
+
+    // Removes a pair this thread owns (claiming or releasing).
+    void erase_pair(std::uint64_t key, size_t slot) {
+        const size_t home = home_of(key);
+        const std::uint64_t bit = std::uint64_t(1) << ((slot - home) & (pair_slots_ - 1));
+        std::uint64_t home_word = homes_[home].load(std::memory_order_acquire);
+        while (!homes_[home].compare_exchange_weak(home_word, (home_word + kVersionOne) & ~bit,
+                                                   std::memory_order_acq_rel)) {
+        }
+        pairs_[slot].store(0, std::memory_order_release);
+    }
+
+    // A place was reserved by the word CAS, so a full ring only means
+    // releases are mid-dequeue; wait for them.
+    static void push_waitlist(Waitlist& q, std::uint32_t student) {
+        std::uint64_t pos = q.tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = q.slots[pos % kRingSize];
+            std::int64_t dif = static_cast<std::int64_t>(slot.seq.load(std::memory_order_acquire) - pos);
+            if (dif == 0) {
+                if (q.tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.student = student;
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return;
+                }
+            } else if (dif < 0) {
+                std::this_thread::yield();
+                pos = q.tail.load(std::memory_order_relaxed);
+            } else {
+                pos = q.tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // A waitlisted student was counted by the word CAS, so an empty ring only
+    // means their claim has not enqueued yet; wait for it.
+    static std::uint32_t pop_waitlist(Waitlist& q) {
+        std::uint64_t pos = q.head.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = q.slots[pos % kRingSize];
+            std::int64_t dif = static_cast<std::int64_t>(slot.seq.load(std::memory_order_acquire) - (pos + 1));
+            if (dif == 0) {
+                if (q.head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    std::uint32_t student = slot.student;
+                    slot.seq.store(pos + kRingSize, std::memory_order_release);
+                    return student;
+                }
+            } else if (dif < 0) {
+                std::this_thread::yield();
+                pos = q.head.load(std::memory_order_relaxed);
+            } else {
+                pos = q.head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t count_ = 0;
+    std::vector<std::uint16_t> capacity_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> state_;
+    std::unique_ptr<Waitlist[]> waitlists_;
+    size_t pair_slots_ = 0;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> homes_;  // per home: version and slot bitmap
+    std::unique_ptr<std::atomic<std::uint64_t>[]> pairs_;  // pair words
+};
+
+// Blocked Bloom filter over course numbers. Each key maps to one 64-byte block
+// and sets one bit in each of its eight words, so a probe reads a single cache
+// line and AND-reduces eight words. Used in front of the map to reject misses.
+class BlockedBloom {
+public:
+    static constexpr size_t kBitsPerKey = 12;
+
+    // Sizes the filter for about n keys and clears it.
+    void reset(size_t n) {
+        size_t blocks = n ? (n * kBitsPerKey + 511) / 512 : 0;
+        blocks_.assign(blocks, Block{});
+        keys_ = 0;
+    }
+    bool enabled() const { return !blocks_.empty(); }
+
+    void insert(std::string_view key) {
+        if (!enabled()) return;
+        std::uint64_t h = mix(CourseKeyHash()(key));
+        Block& b = blocks_[block_index(h)];
+        std::uint64_t bits = mix(h + 0x9e3779b97f4a7c15ULL);
+        for (size_t w = 0; w < 8; ++w) b.words[w] |= 1ULL << ((bits >> (6 * w)) & 63);
+        ++keys_;
+    }
+
+    // False means the key is definitely absent; always true when disabled.
+    bool may_contain(std::string_view key) const {
+        if (!enabled()) return true;
+        std::uint64_t h = mix(CourseKeyHash()(key));
+        const Block& b = blocks_[block_index(h)];
+        std::uint64_t bits = mix(h + 0x9e3779b97f4a7c15ULL);
+        std::uint64_t miss = 0;
+        for (size_t w = 0; w < 8; ++w) miss |= ~b.words[w] & (1ULL << ((bits >> (6 * w)) & 63));
+        return miss == 0;
+    }
+
+    size_t bytes() const { return blocks_.size() * sizeof(Block); }
+
+    // Expected false-positive rate for the keys inserted so far, averaging
+    // over the Poisson spread of keys per block.
+    double false_positive_rate() const {
+        if (!enabled()) return 1.0;
+        double lambda = static_cast<double>(keys_) / static_cast<double>(blocks_.size());
+        double p_load = std::exp(-lambda);  // P(block holds l keys), starting at l = 0
+        double rate = 0.0;
+        size_t max_load = static_cast<size_t>(lambda + 12.0 * std::sqrt(lambda + 1.0) + 12.0);
+        for (size_t l = 0; l <= max_load; ++l) {
+            double bit_set = 1.0 - std::pow(63.0 / 64.0, static_cast<double>(l));
+            rate += p_load * std::pow(bit_set, 8.0);
+            p_load *= lambda / static_cast<double>(l + 1);
+        }
+        return rate;
+    }
+
+private:
+    struct alignas(64) Block {
+        std::uint64_t words[8] = {};
+    };
+
+    size_t block_index(std::uint64_t h) const {
+        return static_cast<size_t>(((h >> 32) * static_cast<std::uint64_t>(blocks_.size())) >> 32);
+    }
+    static std::uint64_t mix(std::uint64_t h) {  // murmur3 finalizer
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    std::vector<Block> blocks_;
+    size_t keys_ = 0;
+};
+
+// Numeric per-course columns kept next to the records for filter scans.
+enum NumericColumn : size_t { kLevelCol, kPrereqCountCol, kCreditsCol, kCapacityCol, kNumericColumns };
+
+// Department code of a course number: its leading letters ("CSCI200" -> "CSCI").
+static inline std::string_view course_dept(std::string_view number) {
+    size_t n = 0;
+    while (n < number.size() && std::isalpha(static_cast<unsigned char>(number[n]))) ++n;
+    return number.substr(0, n);
+}
+
+// Course level: the typed column if given, else the first digit of the
+// number in hundreds ("CSCI350" -> 300).
+static inline std::uint16_t course_level(const Course& c) {
+    if (c.level) return c.level;
+    std::string_view num = c.number;
+    size_t i = course_dept(num).size();
+    if (i < num.size() && num[i] >= '0' && num[i] <= '9') return static_cast<std::uint16_t>((num[i] - '0') * 100);
+    return 0;
+}
+
+// Calls fn(token) for each completion token of a course: its number and each
+// title word of two or more letters/digits, uppercased and capped in length.
+template <typename Fn>
+static void for_each_completion_token(const Course& c, Fn fn) {
+    constexpr size_t kMaxTokenLength = 16;
+    fn(upper(c.number.substr(0, kMaxTokenLength)));
+    const std::string& t = c.title;
+    size_t i = 0;
+    while (i < t.size()) {
+        while (i < t.size() && !std::isalnum(static_cast<unsigned char>(t[i]))) ++i;
+        size_t j = i;
+        while (j < t.size() && std::isalnum(static_cast<unsigned char>(t[j]))) ++j;
+        if (j - i >= 2) fn(upper(t.substr(i, std::min(j - i, kMaxTokenLength))));
+        i = j;
+    }
+}
+
+// Prefix trie over course numbers and title words. Every node keeps the top
+// kTopK courses under it (most dependents first, then by number), so a
+// keystroke is answered by walking the typed prefix only.
+class Autocomplete {
+public:
+    static constexpr size_t kTopK = 8;
+
+    void clear() {
+        nodes_.assign(1, Node{});
+        rank_.clear();
+    }
+    bool built() const { return !nodes_.empty(); }
+
+    // Adds the tokens of courses[id]; popularity orders suggestions. Each id
+    // is inserted once into a fresh trie, since per-node lists assume ranks
+    // never change after an id is offered.
+    void insert(const std::vector<Course>& courses, std::uint32_t id, std::uint32_t popularity) {
+        if (!built()) clear();
+        if (rank_.size() <= id) rank_.resize(id + 1, 0);
+        rank_[id] = popularity;
+        for_each_completion_token(courses[id], [&](const std::string& token) {
+            std::uint32_t node = 0;
+            for (char ch : token) {
+                node = add_child(node, ch);
+                offer(nodes_[node], courses, id);
+            }
+        });
+    }
+
+    // Course ids for a prefix (case-insensitive), best first.
+    std::vector<std::uint32_t> complete(const std::string& prefix) const {
+        std::vector<std::uint32_t> ids;
+        if (!built() || prefix.empty()) return ids;
+        std::uint32_t node = 0;
+        for (char ch : upper(prefix)) {
+            node = find_child(node, ch);
+            if (node == kNone) return ids;
+        }
+        const Node& nd = nodes_[node];
+        ids.assign(nd.top, nd.top + nd.count);
+        return ids;
+    }
+
+private:
+    static constexpr std::uint32_t kNone = UINT32_MAX;
+    struct Node {
+        std::uint32_t first_child = kNone;
+        std::uint32_t next_sibling = kNone;
+        char ch = 0;
+        std::uint8_t count = 0;
+        std::uint32_t top[kTopK] = {};
+    };
+
+    std::uint32_t find_child(std::uint32_t node, char ch) const {
+        std::uint32_t c = nodes_[node].first_child;
+        while (c != kNone && nodes_[c].ch != ch) c = nodes_[c].next_sibling;
+        return c;
+    }
+    std::uint32_t add_child(std::uint32_t node, char ch) {
+        std::uint32_t c = find_child(node, ch);
+        if (c != kNone) return c;
+        Node fresh;
+        fresh.ch = ch;
+        fresh.next_sibling = nodes_[node].first_child;
+        nodes_.push_back(fresh);
+        c = static_cast<std::uint32_t>(nodes_.size() - 1);
+        nodes_[node].first_child = c;
+        return c;
+    }
+
+    // Places id into a node's ranked top-k list if it belongs there.
+    void offer(Node& nd, const std::vector<Course>& courses, std::uint32_t id) const {
+        for (size_t i = 0; i < nd.count; ++i) {
+            if (nd.top[i] == id) return;
+        }
+        auto better = [&](std::uint32_t other) {
+            if (rank_[id] != rank_[other]) return rank_[id] > rank_[other];
+            return courses[id].number < courses[other].number;
+        };
+        size_t pos = nd.count;
+        while (pos > 0 && better(nd.top[pos - 1])) --pos;
+        if (pos >= kTopK) return;
+        size_t last = std::min<size_t>(nd.count, kTopK - 1);
+        for (size_t i = last; i > pos; --i) nd.top[i] = nd.top[i - 1];
+        nd.top[pos] = id;
+        if (nd.count < kTopK) ++nd.count;
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> rank_;
+};
+
+// Orderings the course list can be printed in.
+enum class CourseOrder : size_t { Number, Title, DeptLevel, Depth, kCount };
+
+// In-memory catalog. Courses live in a vector indexed by a dense id, with an
+// unordered_map from course number to id for O(1) lookups. Small per-id
+// columns (department, level, prerequisite count, ...) sit beside the records
+// so filters can scan them without touching each Course.
 // Sorted output is produced by collecting keys and sorting when needed.
 class CourseCatalog {
 public:
-    void upsert(const Course& c) { data_[upper(c.number)] = c; }
-    bool contains(const std::string& number) const { return data_.find(upper(number)) != data_.end(); }
+    using Id = std::uint32_t;
+
+    // Pre-sizes storage and the lookup filter for about n courses.
+    void reserve(size_t n) {
+        courses_.reserve(n);
+        index_.reserve(n);
+        bloom_.reset(std::max(n, index_.size()));
+        for (const auto& kv : index_) bloom_.insert(kv.first);
+    }
+    void upsert(const Course& c) {
+        std::string key = upper(c.number);
+        auto it = index_.find(key);
+        Id id;
+        if (it != index_.end()) {
+            id = it->second;
+            for (auto& ids : orders_) {
+                auto pos = std::find(ids.begin(), ids.end(), id);
+                if (pos != ids.end()) ids.erase(pos);
+            }
+            courses_[id] = c;
+        } else {
+            id = static_cast<Id>(courses_.size());
+            bloom_.insert(key);
+            index_.emplace(std::move(key), id);
+            courses_.push_back(c);
+            dept_.push_back(0);
+            for (auto& col : numeric_) col.push_back(0);
+        }
+        dept_[id] = intern_dept(course_dept(c.number));
+        numeric_[kLevelCol][id] = course_level(c);
+        numeric_[kPrereqCountCol][id] = static_cast<std::uint16_t>(std::min<size_t>(c.prereqs.size(), UINT16_MAX));
+        numeric_[kCreditsCol][id] = c.credits;
+        numeric_[kCapacityCol][id] = c.capacity;
+        // Suggestion ranks count dependents across the whole catalog, so a
+        // changed course drops the trie; build_completions rebuilds it (every
+        // load does, and option 13 does on demand)
+        completions_ = Autocomplete();
+
+        // Keep precomputed orders current; depth can shift for other courses
+        // too, so that order is dropped and rebuilt on next use
+        depth_.resize(courses_.size(), 0);
+        orders_[static_cast<size_t>(CourseOrder::Depth)].clear();
+        for (size_t o = 0; o < orders_.size(); ++o) {
+            std::vector<Id>& ids = orders_[o];
+            if (ids.empty()) continue;
+            CourseOrder order = static_cast<CourseOrder>(o);
+            ids.insert(std::upper_bound(ids.begin(), ids.end(), id,
+                                        [&](Id a, Id b) { return order_less(order, a, b); }), id);
+        }
+    }
+
+    // Strict weak ordering of course ids for each CourseOrder; ties go by number.
+    bool order_less(CourseOrder order, Id a, Id b) const {
+        const Course& x = courses_[a];
+        const Course& y = courses_[b];
+        switch (order) {
+            case CourseOrder::Title:
+                if (x.title != y.title) return x.title < y.title;
+                break;
+            case CourseOrder::DeptLevel: {
+                std::string_view dx = course_dept(x.number), dy = course_dept(y.number);
+                if (dx != dy) return dx < dy;
+                if (numeric_[kLevelCol][a] != numeric_[kLevelCol][b]) return numeric_[kLevelCol][a] < numeric_[kLevelCol][b];
+                break;
+            }
+            case CourseOrder::Depth:
+                if (depth_[a] != depth_[b]) return depth_[a] < depth_[b];
+                break;
+            default:
+                break;
+        }
+        return x.number < y.number;
+    }
+
+    // Installs precomputed orders (see build_course_orders) and per-course prerequisite depth.
+    void set_orders(std::vector<std::uint16_t> depth, std::vector<std::vector<Id>> orders) {
+        depth_ = std::move(depth);
+        for (size_t o = 0; o < orders_.size() && o < orders.size(); ++o) orders_[o] = std::move(orders[o]);
+    }
+    bool order_ready(CourseOrder order) const {
+        return empty() || !orders_[static_cast<size_t>(order)].empty();
+    }
+    const std::vector<Id>& order(CourseOrder order) const { return orders_[static_cast<size_t>(order)]; }
+    std::uint16_t prereq_depth(Id id) const { return depth_[id]; }
+
+    // (Re)builds the autocomplete trie, ranking courses by how many others list them.
+    void build_completions() {
+        std::vector<std::uint32_t> dependents(courses_.size(), 0);
+        for (const Course& c : courses_) {
+            for (const std::string& pre : c.prereqs) {
+                Id u;
+                if (find_id(pre, u)) ++dependents[u];
+            }
+        }
+        completions_.clear();
+        for (Id id = 0; id < courses_.size(); ++id) completions_.insert(courses_, id, dependents[id]);
+    }
+    // Up to Autocomplete::kTopK courses whose number or a title word starts with prefix.
+    std::vector<Id> complete(const std::string& prefix) const {
+        return completions_.complete(prefix);
+    }
+    bool completions_ready() const { return empty() || completions_.built(); }
+    bool contains(const std::string& number) const { return get(number) != nullptr; }
+    // Looks up a course's id; false if the course is not in the catalog.
+    bool find_id(const std::string& number, Id& out) const {
+        if (!bloom_.may_contain(number)) return false;
+        auto it = index_.find(number);
+        if (it == index_.end()) return false;
+        out = it->second;
+        return true;
+    }
     const Course* get(const std::string& number) const {
-        auto it = data_.find(upper(number));
-        return (it == data_.end()) ? nullptr : &it->second;
-    }
-    std::vector<std::string> sorted_numbers() const {
-        std::vector<std::string> keys;
-        keys.reserve(data_.size());
-        for (const auto& kv : data_) keys.push_back(kv.first);
-        std::sort(keys.begin(), keys.end());
-        return keys;
-    }
-    void clear() { data_.clear(); }
-    bool empty() const { return data_.empty(); }
+        if (!bloom_.may_contain(number)) return nullptr;
+        auto it = index_.find(number);
+        return (it == index_.end()) ? nullptr : &courses_[it->second];
+    }
+    void clear() { *this = CourseCatalog(); }
+    bool empty() const { return courses_.empty(); }
+    size_t size() const { return courses_.size(); }
+    const BlockedBloom& lookup_filter() const { return bloom_; }
+
+    // Sections are replaced as a whole when a sections file is loaded.
+    // Seat reservations start empty for the new sections.
+    void set_sections(std::vector<Section> sections) {
+        sections_ = std::move(sections);
+        section_index_.clear();
+        for (size_t i = 0; i < sections_.size(); ++i) section_index_[sections_[i].key] = i;
+        seats_.reset(sections_);
+    }
+    const std::vector<Section>& sections() const { return sections_; }
+    const Section* find_section(const std::string& key) const {
+        auto it = section_index_.find(key);
+        return (it == section_index_.end()) ? nullptr : &sections_[it->second];
+    }
+    size_t section_index(const Section& s) const { return static_cast<size_t>(&s - sections_.data()); }
+    SeatLedger& seat_ledger() { return seats_; }
+
+    // Column access for scans; ids run from 0 to size() - 1.
+    const Course& course(Id id) const { return courses_[id]; }
+    const std::vector<std::uint32_t>& dept_column() const { return dept_; }
+    const std::vector<std::uint16_t>& numeric_column(NumericColumn col) const { return numeric_[col]; }
+    // Looks up a department code's id; false if no course has that department.
+    bool find_dept(std::string_view code, std::uint32_t& out) const {
+        auto it = dept_ids_.find(std::string(code));
+        if (it == dept_ids_.end()) return false;
+        out = it->second;
+        return true;
+    }
+    size_t dept_count() const { return dept_names_.size(); }
+    const std::string& dept_name(std::uint32_t dept) const { return dept_names_[dept]; }
+
 private:
-    std::unordered_map<std::string, Course> data_;
+    std::uint32_t intern_dept(std::string_view code) {
+        auto it = dept_ids_.find(std::string(code));
+        if (it != dept_ids_.end()) return it->second;
+        std::uint32_t id = static_cast<std::uint32_t>(dept_ids_.size());
+        dept_names_.push_back(upper(std::string(code)));
+        dept_ids_.emplace(dept_names_.back(), id);
+        return id;
+    }
+
+    std::vector<Course> courses_;
+    std::unordered_map<std::string, Id, CourseKeyHash, CourseKeyEq> index_;
+    std::unordered_map<std::string, std::uint32_t, CourseKeyHash, CourseKeyEq> dept_ids_;
+    std::vector<std::uint32_t> dept_;
+    std::vector<std::string> dept_names_;  // indexed by department id
+    std::vector<std::uint16_t> numeric_[kNumericColumns];
+    BlockedBloom bloom_;
+    std::vector<Section> sections_;
+    std::unordered_map<std::string, size_t, CourseKeyHash, CourseKeyEq> section_index_;
+    SeatLedger seats_;
+    Autocomplete completions_;
+    std::vector<std::uint16_t> depth_;  // longest prerequisite chain below each course
+    std::array<std::vector<Id>, static_cast<size_t>(CourseOrder::kCount)> orders_;
 };
 
 // ------------------------------ Loading --------------------------------------
-// Reads the CSV file into the provided catalog.
-// Returns true on success; false with error message on failure.
-// Uses a temporary catalog to avoid partially mutating on errors.
-bool load_catalog_from_csv(const std::string& file_path, CourseCatalog& out_catalog, std::string& err) {
-    std::ifstream fin(file_path);
-    if (!fin) {
-        err = "Could not open file: " + file_path;
+// What a CSV column holds. Files without a header row use the assignment's
+// positional layout: number, title, then prerequisites.
+enum class Column : std::uint8_t { Ignore, Number, Title, Prereq, Credits, Level, Terms, Capacity };
+
+// Column roles taken from the header row (if any).
+struct CsvSchema {
+    std::vector<Column> columns;    // empty = positional layout
+    bool extra_are_prereqs = true;  // fields past the last named column
+    size_t first_row = 0;           // 1 when row 0 was the header
+    size_t number_col = 0;
+    size_t title_col = 1;
+
+    Column role(size_t i) const {
+        if (columns.empty()) return i == 0 ? Column::Number : i == 1 ? Column::Title : Column::Prereq;
+        if (i < columns.size()) return columns[i];
+        return extra_are_prereqs ? Column::Prereq : Column::Ignore;
+    }
+};
+
+// Maps a header name to its column role ("Course Number" -> Number, ...).
+static Column column_for_header(std::string_view name) {
+    std::string key;
+    for (char ch : name) {
+        if (std::isalnum(static_cast<unsigned char>(ch))) key += static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    if (key == "coursenumber" || key == "number" || key == "course" || key == "code") return Column::Number;
+    if (key == "coursetitle" || key == "title" || key == "name") return Column::Title;
+    if (key.compare(0, 6, "prereq") == 0) return Column::Prereq;
+    if (key == "credits" || key == "credit") return Column::Credits;
+    if (key == "level") return Column::Level;
+    if (key == "terms" || key == "termsoffered" || key == "term") return Column::Terms;
+    if (key == "capacity" || key == "seats") return Column::Capacity;
+    return Column::Ignore;
+}
+
+// Treats row 0 as a header if its first field names the course number column.
+// Returns true on success; false with error message if the header is unusable.
+static bool detect_schema(const TokenizedCsv& rows, CsvSchema& schema, std::string& err) {
+    if (rows.rows() == 0 || column_for_header(rows.field(0, 0)) != Column::Number) return true;
+
+    bool has_title = false;
+    for (size_t i = 0; i < rows.field_count(0); ++i) {
+        Column col = column_for_header(rows.field(0, i));
+        if (col == Column::Number) schema.number_col = i;
+        if (col == Column::Title && !has_title) {
+            schema.title_col = i;
+            has_title = true;
+        }
+        schema.columns.push_back(col);
+    }
+    if (!has_title) {
+        std::ostringstream oss;
+        oss << "Header on line " << rows.row_line[0] << " has no course title column.";
+        err = oss.str();
         return false;
     }
+    schema.extra_are_prereqs = schema.columns.back() == Column::Prereq;
+    schema.first_row = 1;
+    return true;
+}
 
-    CourseCatalog temp;
-    std::string line;
-    size_t line_no = 0;
+// Parses a terms field into TermBit flags. Terms are separated by '|', ';',
+// '/' or spaces, e.g. "Fall|Spring" or "FA SP".
+static bool parse_terms(std::string_view f, std::uint8_t& mask) {
+    size_t i = 0;
+    while (i < f.size()) {
+        size_t j = f.find_first_of("|;/ ", i);
+        if (j == std::string_view::npos) j = f.size();
+        std::string term = upper(std::string(f.substr(i, j - i)));
+        if (term == "FALL" || term == "FA" || term == "F") mask |= kFall;
+        else if (term == "SPRING" || term == "SP" || term == "S") mask |= kSpring;
+        else if (term == "SUMMER" || term == "SU") mask |= kSummer;
+        else if (term == "WINTER" || term == "WI" || term == "W") mask |= kWinter;
+        else if (!term.empty()) return false;
+        i = j + 1;
+    }
+    return true;
+}
 
-    while (std::getline(fin, line)) {
-        ++line_no;
-        line = trim(line);
-        if (line.empty()) continue;  // skip blank lines
+// Parses a small unsigned integer field; empty means "not given" (0).
+template <typename T>
+static bool parse_uint_field(std::string_view f, T& out) {
+    unsigned long v = 0;
+    for (char ch : f) {
+        if (ch < '0' || ch > '9') return false;
+        v = v * 10 + static_cast<unsigned long>(ch - '0');
+        if (v > static_cast<unsigned long>(static_cast<T>(~T(0)))) return false;
+    }
+    out = static_cast<T>(v);
+    return true;
+}
+
+// Per-column parsers for the typed columns. Each writes straight into the
+// compact field on Course; returns false if the text is not valid for it.
+template <Column C> struct ColumnParser;
+
+template <> struct ColumnParser<Column::Credits> {
+    static bool parse(std::string_view f, Course& c) { return parse_uint_field(f, c.credits); }
+};
+
+template <> struct ColumnParser<Column::Level> {
+    static bool parse(std::string_view f, Course& c) { return parse_uint_field(f, c.level); }
+};
+
+template <> struct ColumnParser<Column::Capacity> {
+    static bool parse(std::string_view f, Course& c) { return parse_uint_field(f, c.capacity); }
+};
 
-        auto fields = split_csv_simple(line);
-        if (fields.size() < 2) {
+template <> struct ColumnParser<Column::Terms> {
+    static bool parse(std::string_view f, Course& c) { return parse_terms(f, c.terms); }
+};
+
+// Checks every tokenized row before anything is built.
+// Returns true on success; false with error message for the first bad row.
+static bool validate_rows(const TokenizedCsv& rows, const CsvSchema& schema, std::string& err) {
+    const size_t needed = std::max(schema.number_col, schema.title_col) + 1;
+    for (size_t r = schema.first_row; r < rows.rows(); ++r) {
+        if (rows.field_count(r) < needed) {
             std::ostringstream oss;
-            oss << "Parse error on line " << line_no << ": need at least courseNumber and courseTitle.";
+            oss << "Parse error on line " << rows.row_line[r] << ": need at least courseNumber and courseTitle.";
             err = oss.str();
             return false;
         }
-
-        std::string number = upper(fields[0]);
-        std::string title  = fields[1];
-
-        if (number.empty() || title.empty()) {
+        if (rows.field(r, schema.number_col).empty() || rows.field(r, schema.title_col).empty()) {
             std::ostringstream oss;
-            oss << "Invalid data on line " << line_no << ": empty course number or title.";
+            oss << "Invalid data on line " << rows.row_line[r] << ": empty course number or title.";
             err = oss.str();
             return false;
         }
+    }
+    return true;
+}
 
-        Course c(number, title);
+// Builds the Course for one validated row according to the schema.
+// Returns true on success; false with error message on a bad typed value.
+static bool build_course(const TokenizedCsv& rows, size_t r, const CsvSchema& schema, Course& c, std::string& err) {
+    c = Course(upper(std::string(rows.field(r, schema.number_col))), std::string(rows.field(r, schema.title_col)));
 
-        // Any remaining fields are prerequisites (normalize to uppercase)
-        for (size_t i = 2; i < fields.size(); ++i) {
-            std::string prereq = upper(fields[i]);
-            if (!prereq.empty()) c.prereqs.push_back(prereq);
+    // Remaining fields by column role; prerequisites are normalized to uppercase
+    for (size_t i = 0; i < rows.field_count(r); ++i) {
+        std::string_view f = rows.field(r, i);
+        bool ok = true;
+        switch (schema.role(i)) {
+            case Column::Prereq:
+                if (!f.empty()) c.prereqs.push_back(upper(std::string(f)));
+                break;
+            case Column::Credits:  ok = ColumnParser<Column::Credits>::parse(f, c); break;
+            case Column::Level:    ok = ColumnParser<Column::Level>::parse(f, c); break;
+            case Column::Terms:    ok = ColumnParser<Column::Terms>::parse(f, c); break;
+            case Column::Capacity: ok = ColumnParser<Column::Capacity>::parse(f, c); break;
+            default: break;  // number/title already taken; unknown columns ignored
         }
+        if (!ok) {
+            std::ostringstream oss;
+            oss << "Invalid data on line " << rows.row_line[r] << ": bad value '" << f << "' in column " << (i + 1) << ".";
+            err = oss.str();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parses one raw CSV line into a Course using the file's schema.
+// Returns true on success; false with error message if the row is invalid.
+static bool parse_row_text(std::string line, std::uint32_t line_no, const CsvSchema& schema, Course& c,
+                           std::string& err) {
+    TokenizedCsv row;
+    row.buf = std::move(line);
+    tokenize_buffer(row, line_no);
+    CsvSchema single = schema;
+    single.first_row = 0;
+    if (row.rows() != 1) {
+        std::ostringstream oss;
+        oss << "Parse error on line " << line_no << ": expected one course row.";
+        err = oss.str();
+        return false;
+    }
+    return validate_rows(row, single, err) && build_course(row, 0, single, c, err);
+}
+
+// Trimmed text of the n-th comma-separated field of a raw line ("" if absent).
+static std::string csv_field(const std::string& line, size_t n) {
+    size_t begin = 0;
+    for (size_t i = 0; i < n && begin != std::string::npos; ++i) {
+        begin = line.find(',', begin);
+        if (begin != std::string::npos) ++begin;
+    }
+    if (begin == std::string::npos) return "";
+    size_t end = line.find(',', begin);
+    return trim(line.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+}
+
+void build_course_orders(CourseCatalog& catalog);  // defined with the prerequisite graph
 
+// Reads the CSV file into the provided catalog.
+// Returns true on success; false with error message on failure.
+// Uses a temporary catalog to avoid partially mutating on errors.
+// If a timer is given, the tokenize/validate/build phases are reported to it.
+bool load_catalog_from_csv(const std::string& file_path, CourseCatalog& out_catalog, std::string& err,
+                           OpTimer* timer = nullptr) {
+    TokenizedCsv rows;
+    if (!tokenize_csv(file_path, rows, err)) return false;
+    if (timer) timer->phase("tokenize");
+    CsvSchema schema;
+    if (!detect_schema(rows, schema, err)) return false;
+    if (!validate_rows(rows, schema, err)) return false;
+    if (timer) timer->phase("validate");
+
+    CourseCatalog temp;
+    temp.reserve(rows.rows() - schema.first_row);
+    for (size_t r = schema.first_row; r < rows.rows(); ++r) {
+        Course c;
+        if (!build_course(rows, r, schema, c, err)) return false;
         temp.upsert(c);
     }
+    temp.build_completions();
+    build_course_orders(temp);
+    if (timer) timer->phase("build");
 
-    // Success: commit populated temp catalog
+    // Success: commit populated temp catalog (the tokenized rows are released on return)
     out_catalog = std::move(temp);
     return true;
 }
 
+// ------------------------------ Lazy lookups ---------------------------------
+// Lookup-only view of a CSV file. Opening it makes one pass that records
+// each course number's byte offset and line, without parsing rows. A row is
+// parsed the first time it is asked for and then cached, so memory grows
+// with the number of keys rather than full records.
+class LazyCatalog {
+public:
+    // Returns true on success; false with error message on failure.
+    bool open(const std::string& file_path, std::string& err) {
+        std::ifstream fin(file_path, std::ios::binary);
+        if (!fin) {
+            err = "Could not open file: " + file_path;
+            return false;
+        }
+        std::unordered_map<std::string, RowRef, CourseKeyHash, CourseKeyEq> offsets;
+        CsvSchema schema;
+        std::string line;
+        std::uint64_t offset = 0;
+        std::uint32_t line_no = 0;
+        bool first_row = true;
+        while (std::getline(fin, line)) {
+            std::uint64_t line_start = offset;
+            offset += line.size() + 1;
+            ++line_no;
+            size_t comma = line.find(',');
+            std::string key = trim(line.substr(0, comma));
+            if (key.empty() && trim(line).empty()) continue;  // blank line
+
+            if (first_row) {
+                first_row = false;
+                TokenizedCsv head;
+                head.buf = line;
+                tokenize_buffer(head, line_no);
+                if (!detect_schema(head, schema, err)) return false;
+                if (schema.first_row == 1) continue;
+            }
+            if (schema.number_col != 0) key = csv_field(line, schema.number_col);
+            offsets[upper(key)] = RowRef{line_start, line_no};
+        }
+
+        schema.first_row = 0;  // rows are parsed one at a time from here on
+        file_path_ = file_path;
+        schema_ = std::move(schema);
+        offsets_ = std::move(offsets);
+        cache_.clear();
+        return true;
+    }
+
+    bool is_open() const { return !file_path_.empty(); }
+    void close() { *this = LazyCatalog(); }
+    size_t size() const { return offsets_.size(); }
+
+    // Returns the course (parsing and caching its row on first use), or
+    // nullptr if it is not in the file or its row is invalid (err is set).
+    const Course* get(const std::string& number, std::string& err) {
+        auto hit = cache_.find(number);
+        if (hit != cache_.end()) return &hit->second;
+        auto it = offsets_.find(number);
+        if (it == offsets_.end()) return nullptr;
+
+        std::ifstream fin(file_path_, std::ios::binary);
+        std::string line;
+        fin.seekg(static_cast<std::streamoff>(it->second.offset));
+        if (!fin || !std::getline(fin, line)) {
+            err = "Could not re-read " + file_path_ + " (was it changed?).";
+            return nullptr;
+        }
+        Course c;
+        if (!parse_row_text(std::move(line), it->second.line, schema_, c, err)) return nullptr;
+        return &cache_.emplace(it->first, std::move(c)).first->second;
+    }
+
+private:
+    struct RowRef {
+        std::uint64_t offset;
+        std::uint32_t line;
+    };
+
+    std::string file_path_;
+    CsvSchema schema_;
+    std::unordered_map<std::string, RowRef, CourseKeyHash, CourseKeyEq> offsets_;
+    std::unordered_map<std::string, Course, CourseKeyHash, CourseKeyEq> cache_;
+};
+
+// ---------------------------- Sorted-file lookups -----------------------------
+// Lookups straight from a CSV already sorted by course number, with no load
+// step: each lookup binary-searches byte offsets, realigning every probe to
+// the next line start, so it touches O(log n) pages of the file.
+class SortedCsvFile {
+public:
+    // Opens the file and spot-checks that sampled rows are in key order.
+    // Returns true on success; false with error message on failure.
+    bool open(const std::string& file_path, std::string& err) {
+        close();
+        file_.open(file_path, std::ios::binary);
+        if (!file_) {
+            err = "Could not open file: " + file_path;
+            return false;
+        }
+        file_.seekg(0, std::ios::end);
+        size_ = static_cast<std::uint64_t>(file_.tellg());
+
+        Row first;
+        if (read_row(0, first)) {
+            TokenizedCsv head;
+            head.buf = first.line;
+            tokenize_buffer(head);
+            if (!detect_schema(head, schema_, err)) return false;
+            if (schema_.first_row == 1) data_start_ = first.end;
+        }
+
+        const int kProbes = 32;
+        std::string prev;
+        for (int i = 0; i <= kProbes; ++i) {
+            Row r;
+            std::uint64_t at = data_start_ + (size_ - data_start_) * static_cast<std::uint64_t>(i) / kProbes;
+            if (!read_row(next_line_start(at), r)) break;
+            std::string key = key_of(r.line);
+            if (key < prev) {
+                err = file_path + " is not sorted by course number.";
+                file_.close();
+                return false;
+            }
+            prev = std::move(key);
+        }
+        path_ = file_path;
+        return true;
+    }
+
+    void close() {
+        if (file_.is_open()) file_.close();
+        file_.clear();
+        path_.clear();
+        schema_ = CsvSchema();
+        data_start_ = size_ = 0;
+    }
+    bool is_open() const { return !path_.empty(); }
+
+    // Finds a course; false if absent or its row is invalid (err is set).
+    // With duplicate rows the last one wins, as when loading.
+    bool find(const std::string& number, Course& out, std::string& err) {
+        std::string key = upper(trim(number));
+        Row r;
+        bool found = false;
+        std::uint64_t pos = lower_bound(key);
+        while (read_row(pos, r) && key_of(r.line) == key) {
+            if (!parse_row_text(r.line, 0, schema_, out, err)) {
+                err = "Invalid row for " + key + " in " + path_ + ".";
+                return false;
+            }
+            found = true;
+            pos = r.end;
+        }
+        return found;
+    }
+
+    // Up to limit courses whose number starts with prefix, in file order.
+    std::vector<Course> with_prefix(const std::string& prefix, size_t limit, std::string& err) {
+        std::vector<Course> out;
+        std::string key = upper(trim(prefix));
+        Row r;
+        for (std::uint64_t pos = lower_bound(key); out.size() < limit && read_row(pos, r); pos = r.end) {
+            std::string k = key_of(r.line);
+            if (k.compare(0, key.size(), key) != 0) break;
+            Course c;
+            if (!parse_row_text(r.line, 0, schema_, c, err)) {
+                err = "Invalid row for " + k + " in " + path_ + ".";
+                break;
+            }
+            if (!out.empty() && out.back().number == c.number) out.back() = std::move(c);
+            else out.push_back(std::move(c));
+        }
+        return out;
+    }
+
+private:
+    struct Row {
+        std::uint64_t start = 0;  // offset of the row's first byte
+        std::uint64_t end = 0;    // offset just past its newline
+        std::string line;
+    };
+
+    std::string key_of(const std::string& line) const { return upper(csv_field(line, schema_.number_col)); }
+
+    // First line start at or after pos.
+    std::uint64_t next_line_start(std::uint64_t pos) {
+        if (pos <= data_start_) return data_start_;
+        file_.clear();
+        file_.seekg(static_cast<std::streamoff>(pos - 1));
+        std::string skipped;
+        std::getline(file_, skipped);
+        return pos - 1 + skipped.size() + 1;
+    }
+
+    // Reads the first non-blank line starting at or after pos (a line start).
+    bool read_row(std::uint64_t pos, Row& row) {
+        while (pos < size_) {
+            file_.clear();
+            file_.seekg(static_cast<std::streamoff>(pos));
+            if (!std::getline(file_, row.line)) return false;
+            row.start = pos;
+            row.end = pos + row.line.size() + 1;
+            if (!trim(row.line).empty()) return true;
+            pos = row.end;
+        }
+        return false;
+    }
+
+    // Start of the first row whose key is >= key (size_ if none).
+    std::uint64_t lower_bound(const std::string& key) {
+        std::uint64_t lo = data_start_, hi = size_;
+        Row r;
+        while (lo < hi) {
+            std::uint64_t mid = lo + (hi - lo) / 2;
+            if (!read_row(next_line_start(mid), r) || r.start >= hi) {
+                // No row starts in [mid, hi): step over the row at lo instead
+                if (!read_row(lo, r) || r.start >= hi) return hi;
+                if (key_of(r.line) < key) lo = r.end;
+                else hi = r.start;
+                continue;
+            }
+            if (key_of(r.line) < key) lo = r.end;
+            else hi = r.start;
+        }
+        return lo;
+    }
+
+    std::ifstream file_;
+    std::string path_;
+    CsvSchema schema_;
+    std::uint64_t data_start_ = 0;
+    std::uint64_t size_ = 0;
+};
+
+// ------------------------------ External sort --------------------------------
+// Tournament tree of losers over k sorted sources. tree_[1..k-1] hold the
+// loser of each match, leaves sit at k..2k-1, and replaying one leaf after
+// its source advances costs log2(k) comparisons.
+template <typename Less>
+class LoserTree {
+public:
+    LoserTree(size_t k, Less less) : k_(k), less_(less), tree_(std::max<size_t>(k, 1), 0) {
+        winner_ = k_ ? build(1) : 0;
+    }
+    size_t winner() const { return winner_; }
+    void replay(size_t leaf) {
+        size_t w = leaf;
+        for (size_t p = (leaf + k_) / 2; p >= 1; p /= 2) {
+            if (less_(tree_[p], w)) std::swap(tree_[p], w);
+        }
+        winner_ = w;
+    }
+
+private:
+    size_t build(size_t node) {
+        if (node >= k_) return node - k_;
+        size_t l = build(2 * node), r = build(2 * node + 1);
+        if (less_(r, l)) {
+            tree_[node] = l;
+            return r;
+        }
+        tree_[node] = r;
+        return l;
+    }
+
+    size_t k_;
+    Less less_;
+    std::vector<size_t> tree_;
+    size_t winner_ = 0;
+};
+
+// Prints the course list for a file of any size with bounded memory: rows
+// are collected into sorted runs of about run_bytes, spilled to temporary
+// files, then k-way merged with a loser tree while streaming the output.
+// Rows are validated and typed columns parsed with build_course, so the same
+// files are rejected as by the loader, and output matches print_course_list
+// (last duplicate wins). Returns true on success; false with error message.
+// Bad rows are caught before anything is printed; a read error on a run file
+// during the merge stops the listing where it is.
+bool print_course_list_external(const std::string& file_path, std::string& err, size_t run_bytes = 32u << 20) {
+    struct Record {
+        std::string key;
+        std::uint64_t seq;
+        std::string title;
+        bool operator<(const Record& o) const { return key != o.key ? key < o.key : seq < o.seq; }
+    };
+    struct RunFile {
+        std::FILE* f = nullptr;
+        ~RunFile() {
+            if (f) std::fclose(f);
+        }
+    };
+    auto write_str = [](std::FILE* f, const std::string& str) {
+        std::uint32_t n = static_cast<std::uint32_t>(str.size());
+        return std::fwrite(&n, sizeof n, 1, f) == 1 && std::fwrite(str.data(), 1, n, f) == n;
+    };
+    // 1 = read, 0 = clean end of the run, -1 = I/O error or truncated record
+    auto read_str = [](std::FILE* f, std::string& str) {
+        std::uint32_t n = 0;
+        size_t got = std::fread(&n, 1, sizeof n, f);
+        if (got == 0 && std::feof(f) && !std::ferror(f)) return 0;
+        if (got != sizeof n) return -1;
+        str.resize(n);
+        return (n == 0 || std::fread(&str[0], 1, n, f) == n) ? 1 : -1;
+    };
+
+    std::ifstream fin(file_path, std::ios::binary);
+    if (!fin) {
+        err = "Could not open file: " + file_path;
+        return false;
+    }
+
+    // Pass 1: validate rows and spill sorted runs
+    std::vector<std::unique_ptr<RunFile>> runs;
+    std::vector<Record> batch;
+    size_t batch_bytes = 0;
+    auto spill = [&]() {
+        std::sort(batch.begin(), batch.end());
+        auto run = std::make_unique<RunFile>();
+        run->f = std::tmpfile();
+        if (!run->f) return false;
+        for (const Record& r : batch) {
+            if (!write_str(run->f, r.key) || std::fwrite(&r.seq, sizeof r.seq, 1, run->f) != 1 ||
+                !write_str(run->f, r.title)) {
+                return false;
+            }
+        }
+        std::rewind(run->f);
+        runs.push_back(std::move(run));
+        batch.clear();
+        batch_bytes = 0;
+        return true;
+    };
+
+    CsvSchema schema;
+    std::string line;
+    std::uint32_t line_no = 0;
+    bool first = true;
+    while (std::getline(fin, line)) {
+        ++line_no;
+        TokenizedCsv row;
+        row.buf = std::move(line);
+        tokenize_buffer(row, line_no);
+        if (row.rows() == 0) continue;  // blank line
+        if (first) {
+            first = false;
+            if (!detect_schema(row, schema, err)) return false;
+            if (schema.first_row == 1) continue;
+        }
+        CsvSchema single = schema;
+        single.first_row = 0;
+        Course c;
+        if (!validate_rows(row, single, err) || !build_course(row, 0, single, c, err)) return false;
+
+        Record r{std::move(c.number), line_no, std::move(c.title)};
+        batch_bytes += r.key.size() + r.title.size() + sizeof(Record);
+        batch.push_back(std::move(r));
+        if (batch_bytes >= run_bytes && !spill()) {
+            err = "Could not write a temporary run file.";
+            return false;
+        }
+    }
+    if (!batch.empty() && !runs.empty() && !spill()) {
+        err = "Could not write a temporary run file.";
+        return false;
+    }
+
+    // Pass 2: merge (a single in-memory batch is printed directly)
+    std::cout << "Here is a sample schedule:\n";
+    if (runs.empty()) {
+        std::sort(batch.begin(), batch.end());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (i + 1 < batch.size() && batch[i + 1].key == batch[i].key) continue;
+            std::cout << batch[i].key << ", " << batch[i].title << "\n";
+        }
+        std::cout << "\n";
+        return true;
+    }
+
+    const size_t k = runs.size();
+    std::vector<Record> head(k);
+    std::vector<bool> live(k);
+    bool read_failed = false;
+    auto advance = [&](size_t i) {
+        std::FILE* f = runs[i]->f;
+        int got = read_str(f, head[i].key);
+        live[i] = got == 1 && std::fread(&head[i].seq, sizeof head[i].seq, 1, f) == 1 && read_str(f, head[i].title) == 1;
+        if (!live[i] && got != 0) read_failed = true;
+    };
+    for (size_t i = 0; i < k; ++i) advance(i);
+    auto less = [&](size_t a, size_t b) {
+        if (!live[a] || !live[b]) return live[a] && !live[b];
+        return head[a] < head[b];
+    };
+    LoserTree<decltype(less)> tree(k, less);
+
+    Record pending;
+    bool have_pending = false;
+    while (!read_failed && live[tree.winner()]) {
+        size_t w = tree.winner();
+        if (have_pending && pending.key != head[w].key) std::cout << pending.key << ", " << pending.title << "\n";
+        pending = head[w];
+        have_pending = true;
+        advance(w);
+        tree.replay(w);
+    }
+    if (read_failed) {
+        std::cout << "\n";
+        err = "Could not read a temporary run file; the listing above is incomplete.";
+        return false;
+    }
+    if (have_pending) std::cout << pending.key << ", " << pending.title << "\n";
+    std::cout << "\n";
+    return true;
+}
+
+// ------------------------------- Sections ------------------------------------
+// Parses "9:00", "09:00" or "0900" into minutes after midnight.
+static bool parse_clock(std::string_view f, std::uint16_t& minutes) {
+    unsigned h = 0, m = 0;
+    size_t colon = f.find(':');
+    std::string_view hs = (colon == std::string_view::npos) ? f.substr(0, f.size() >= 2 ? f.size() - 2 : 0) : f.substr(0, colon);
+    std::string_view ms = (colon == std::string_view::npos) ? f.substr(hs.size()) : f.substr(colon + 1);
+    if (hs.empty() || ms.size() != 2 || !parse_uint_field(hs, h) || !parse_uint_field(ms, m) || h > 23 || m > 59) return false;
+    minutes = static_cast<std::uint16_t>(h * 60 + m);
+    return true;
+}
+
+// Parses meeting days such as "MWF" or "TR" (R = Thursday, U = Sunday).
+static bool parse_days(std::string_view f, std::uint8_t& days) {
+    static const char letters[] = "MTWRFSU";
+    for (char ch : f) {
+        const char* pos = (ch == '\0') ? nullptr : std::strchr(letters, std::toupper(static_cast<unsigned char>(ch)));
+        if (!pos) return false;
+        days |= static_cast<std::uint8_t>(1u << (pos - letters));
+    }
+    return days != 0;
+}
+
+// Reads a sections file into the catalog, replacing any earlier sections.
+// Columns: course, section, term, days, start, end, seats; an optional
+// header row is skipped. Every course must already be in the catalog.
+// Returns true on success; false with error message (catalog unchanged).
+bool load_sections_from_csv(const std::string& file_path, CourseCatalog& catalog, std::string& err) {
+    TokenizedCsv rows;
+    if (!tokenize_csv(file_path, rows, err)) return false;
+    size_t first = (rows.rows() > 0 && column_for_header(rows.field(0, 0)) == Column::Number) ? 1 : 0;
+
+    std::vector<Section> sections;
+    sections.reserve(rows.rows() - first);
+    for (size_t r = first; r < rows.rows(); ++r) {
+        std::ostringstream oss;
+        oss << "Invalid section on line " << rows.row_line[r] << ": ";
+        if (rows.field_count(r) < 7) {
+            err = oss.str() + "need course, section, term, days, start, end and seats.";
+            return false;
+        }
+        Section s;
+        std::string number(rows.field(r, 0));
+        if (!catalog.find_id(number, s.course)) {
+            err = oss.str() + "unknown course " + upper(number) + ".";
+            return false;
+        }
+        s.key = catalog.course(s.course).number + "-" + upper(std::string(rows.field(r, 1)));
+        if (!parse_terms(rows.field(r, 2), s.terms) || s.terms == 0) {
+            err = oss.str() + "bad term.";
+            return false;
+        }
+        if (!parse_days(rows.field(r, 3), s.days)) {
+            err = oss.str() + "bad meeting days.";
+            return false;
+        }
+        if (!parse_clock(rows.field(r, 4), s.start) || !parse_clock(rows.field(r, 5), s.end) || s.end <= s.start) {
+            err = oss.str() + "bad start/end time.";
+            return false;
+        }
+        if (!parse_uint_field(rows.field(r, 6), s.seats)) {
+            err = oss.str() + "bad seat count.";
+            return false;
+        }
+        sections.push_back(std::move(s));
+    }
+
+    catalog.set_sections(std::move(sections));
+    return true;
+}
+
+// Prerequisites of a course that are not in the completed list.
+static std::vector<std::string> unmet_prereqs(const Course& c, const std::vector<std::string>& completed) {
+    std::vector<std::string> missing;
+    for (const std::string& pre : c.prereqs) {
+        bool done = std::any_of(completed.begin(), completed.end(),
+                                [&pre](const std::string& x) { return CourseKeyEq()(x, pre); });
+        if (!done) missing.push_back(pre);
+    }
+    return missing;
+}
+
+// Result of checking a candidate schedule.
+struct ScheduleCheck {
+    std::vector<std::string> unknown;                          // section keys not found
+    std::vector<std::pair<const Section*, const Section*>> clashes;
+    std::vector<std::pair<const Section*, std::string>> missing_prereqs;
+};
+
+// Validates a schedule for time clashes and unmet prerequisites.
+// Meetings are expanded to one interval per term and weekday, sorted by
+// start, and swept once, so a cart of k sections costs O(k log k).
+ScheduleCheck check_schedule(const CourseCatalog& catalog, const std::vector<std::string>& section_keys,
+                             const std::vector<std::string>& completed) {
+    ScheduleCheck result;
+    std::vector<const Section*> chosen;
+    for (const std::string& key : section_keys) {
+        const Section* s = catalog.find_section(key);
+        if (s) chosen.push_back(s);
+        else result.unknown.push_back(upper(key));
+    }
+
+    struct Meeting {
+        std::uint32_t begin;  // (term, day, minute) packed so clashes sort together
+        std::uint32_t end;
+        const Section* section;
+    };
+    std::vector<Meeting> meetings;
+    for (const Section* s : chosen) {
+        for (std::uint32_t t = 0; t < 4; ++t) {
+            if (!(s->terms & (1u << t))) continue;
+            for (std::uint32_t d = 0; d < 7; ++d) {
+                if (!(s->days & (1u << d))) continue;
+                std::uint32_t base = (t * 7 + d) * 1440;
+                meetings.push_back({base + s->start, base + s->end, s});
+            }
+        }
+    }
+    std::sort(meetings.begin(), meetings.end(), [](const Meeting& a, const Meeting& b) { return a.begin < b.begin; });
+
+    // Sweep: a meeting clashes with every open one that ends after it starts
+    std::vector<const Meeting*> open;
+    for (const Meeting& m : meetings) {
+        open.erase(std::remove_if(open.begin(), open.end(), [&m](const Meeting* o) { return o->end <= m.begin; }), open.end());
+        for (const Meeting* o : open) {
+            if (o->section == m.section) continue;
+            auto pair = (o->section->key < m.section->key) ? std::make_pair(o->section, m.section)
+                                                           : std::make_pair(m.section, o->section);
+            if (std::find(result.clashes.begin(), result.clashes.end(), pair) == result.clashes.end()) {
+                result.clashes.push_back(pair);
+            }
+        }
+        open.push_back(&m);
+    }
+
+    for (const Section* s : chosen) {
+        for (std::string& pre : unmet_prereqs(catalog.course(s->course), completed)) {
+            result.missing_prereqs.emplace_back(s, std::move(pre));
+        }
+    }
+    return result;
+}
+
+// Outcome counts and timing for one stress_seat_ledger run.
+struct SeatStressResult {
+    std::uint64_t ops = 0;
+    std::uint64_t reserved = 0, waitlisted = 0, full = 0, already_listed = 0, untracked = 0;
+    std::uint64_t freed = 0, passed_on = 0, not_holding = 0;
+    size_t threads = 0;
+    size_t sections = 0;
+    double ms = 0;
+    bool consistent = false;
+    std::string err;  // first invariant that failed
+};
+
+// Hammers a fresh ledger for the given sections with random claims and
+// releases from every hardware thread: students come from a shared pool of
+// kStudents, so duplicate claims and releases by non-holders are exercised
+// along with seat handoffs. Only the first 256 sections are used, which
+// keeps contention high. Afterwards the ledger is checked against itself
+// (check_quiescent) and against the outcome counts: seats taken equal
+// claims reserved minus seats freed, and the waitlists hold every
+// waitlisted claim that was not promoted.
+SeatStressResult stress_seat_ledger(const std::vector<Section>& sections, size_t ops) {
+    constexpr std::uint32_t kStudents = 512;
+    std::vector<Section> used(sections.begin(), sections.begin() + std::min<size_t>(sections.size(), 256));
+    SeatLedger ledger;
+    ledger.reset(used);
+
+    struct Counts {
+        alignas(64) std::uint64_t claims[5] = {};
+        std::uint64_t releases[3] = {};
+    };
+    std::vector<Counts> partial(std::max<size_t>(1, std::thread::hardware_concurrency()));
+    SeatStressResult result;
+    auto start = std::chrono::steady_clock::now();
+    result.threads = for_each_chunk(ops, [&](size_t begin, size_t end, size_t chunk) {
+        Counts& counts = partial[chunk];
+        std::uint64_t x = 0x9e3779b97f4a7c15ULL * (chunk + 1);
+        for (size_t i = begin; i < end; ++i) {
+            x ^= x << 13;  // xorshift64
+            x ^= x >> 7;
+            x ^= x << 17;
+            size_t section = static_cast<size_t>(x % used.size());
+            std::uint32_t student = static_cast<std::uint32_t>((x >> 24) % kStudents);
+            if (x >> 63) {
+                ++counts.claims[static_cast<size_t>(ledger.claim(section, student))];
+            } else {
+                std::uint32_t promoted = 0;
+                ++counts.releases[static_cast<size_t>(ledger.release(section, student, promoted))];
+            }
+        }
+    }, 65536);
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    for (const Counts& c : partial) {
+        result.reserved += c.claims[static_cast<size_t>(SeatLedger::Claim::Reserved)];
+        result.waitlisted += c.claims[static_cast<size_t>(SeatLedger::Claim::Waitlisted)];
+        result.full += c.claims[static_cast<size_t>(SeatLedger::Claim::Full)];
+        result.already_listed += c.claims[static_cast<size_t>(SeatLedger::Claim::AlreadyListed)];
+        result.untracked += c.claims[static_cast<size_t>(SeatLedger::Claim::Untracked)];
+        result.freed += c.releases[static_cast<size_t>(SeatLedger::Release::Freed)];
+        result.passed_on += c.releases[static_cast<size_t>(SeatLedger::Release::PassedOn)];
+        result.not_holding += c.releases[static_cast<size_t>(SeatLedger::Release::NotHolding)];
+    }
+    result.ops = ops;
+    result.sections = used.size();
+
+    std::uint64_t taken = 0, waiting = 0;
+    for (size_t s = 0; s < ledger.size(); ++s) {
+        taken += ledger.taken(s);
+        waiting += ledger.waiting(s);
+    }
+    result.consistent = ledger.check_quiescent(result.err);
+    if (result.consistent && (taken != result.reserved - result.freed || waiting != result.waitlisted - result.passed_on)) {
+        result.consistent = false;
+        result.err = "seats taken " + std::to_string(taken) + " and waiting " + std::to_string(waiting) +
+                     " do not match the claim and release outcomes";
+    }
+    return result;
+}
+
+// --------------------------- Prerequisite graph ------------------------------
+// The prerequisite graph over catalog ids in contiguous adjacency arrays
+// (CSR). prereqs_of(v) lists v's prerequisites, dependents_of(v) the courses
+// that list v. Prerequisites that are not in the catalog are left out.
+struct PrereqGraph {
+    std::vector<std::uint32_t> prereq_start, prereq_ids;        // size n + 1, edges
+    std::vector<std::uint32_t> dependent_start, dependent_ids;  // size n + 1, edges
+
+    size_t size() const { return prereq_start.empty() ? 0 : prereq_start.size() - 1; }
+    size_t prereq_count(size_t v) const { return prereq_start[v + 1] - prereq_start[v]; }
+    size_t dependent_count(size_t v) const { return dependent_start[v + 1] - dependent_start[v]; }
+    const std::uint32_t* prereqs_begin(size_t v) const { return prereq_ids.data() + prereq_start[v]; }
+    const std::uint32_t* prereqs_end(size_t v) const { return prereq_ids.data() + prereq_start[v + 1]; }
+    const std::uint32_t* dependents_begin(size_t v) const { return dependent_ids.data() + dependent_start[v]; }
+    const std::uint32_t* dependents_end(size_t v) const { return dependent_ids.data() + dependent_start[v + 1]; }
+};
+
+PrereqGraph build_prereq_graph(const CourseCatalog& catalog) {
+    const size_t n = catalog.size();
+    PrereqGraph g;
+    g.prereq_start.assign(n + 1, 0);
+    g.dependent_start.assign(n + 1, 0);
+
+    for (size_t v = 0; v < n; ++v) {
+        const auto first = static_cast<std::ptrdiff_t>(g.prereq_start[v]);
+        for (const std::string& pre : catalog.course(static_cast<CourseCatalog::Id>(v)).prereqs) {
+            CourseCatalog::Id u;
+            if (!catalog.find_id(pre, u) || u == v) continue;
+            // A row may list a prerequisite twice (e.g. A100,a100); keep one edge, in listed order
+            if (std::find(g.prereq_ids.begin() + first, g.prereq_ids.end(), u) != g.prereq_ids.end()) continue;
+            g.prereq_ids.push_back(u);
+            ++g.dependent_start[u + 1];
+        }
+        g.prereq_start[v + 1] = static_cast<std::uint32_t>(g.prereq_ids.size());
+    }
+
+    for (size_t v = 0; v < n; ++v) g.dependent_start[v + 1] += g.dependent_start[v];
+    g.dependent_ids.resize(g.prereq_ids.size());
+    std::vector<std::uint32_t> fill(g.dependent_start.begin(), g.dependent_start.end() - 1);
+    for (size_t v = 0; v < n; ++v) {
+        for (const std::uint32_t* p = g.prereqs_begin(v); p != g.prereqs_end(v); ++p) {
+            g.dependent_ids[fill[*p]++] = static_cast<std::uint32_t>(v);
+        }
+    }
+    return g;
+}
+
+// Computes prerequisite depth (longest chain below a course; courses on a
+// cycle get UINT16_MAX) and sorts one id permutation per CourseOrder, each
+// on its own thread, then installs them in the catalog.
+void build_course_orders(CourseCatalog& catalog) {
+    const size_t n = catalog.size();
+    PrereqGraph g = build_prereq_graph(catalog);
+    std::vector<std::uint16_t> depth(n, UINT16_MAX);
+    std::vector<std::uint32_t> pending(n), ready;
+    for (size_t v = 0; v < n; ++v) {
+        pending[v] = static_cast<std::uint32_t>(g.prereq_count(v));
+        if (pending[v] == 0) {
+            depth[v] = 0;
+            ready.push_back(static_cast<std::uint32_t>(v));
+        }
+    }
+    for (size_t head = 0; head < ready.size(); ++head) {
+        std::uint32_t u = ready[head];
+        for (const std::uint32_t* w = g.dependents_begin(u); w != g.dependents_end(u); ++w) {
+            std::uint16_t d = static_cast<std::uint16_t>(std::min<int>(depth[u] + 1, UINT16_MAX - 1));
+            if (depth[*w] == UINT16_MAX || depth[*w] < d) depth[*w] = d;
+            if (--pending[*w] == 0) ready.push_back(*w);
+        }
+    }
+    for (size_t v = 0; v < n; ++v) {
+        if (pending[v] != 0) depth[v] = UINT16_MAX;  // never released: on or behind a cycle
+    }
+    catalog.set_orders(depth, {});
+
+    std::vector<std::future<std::vector<CourseCatalog::Id>>> jobs;
+    for (size_t o = 0; o < static_cast<size_t>(CourseOrder::kCount); ++o) {
+        jobs.push_back(std::async(n > 16384 ? std::launch::async : std::launch::deferred, [&catalog, n, o] {
+            std::vector<CourseCatalog::Id> ids(n);
+            for (size_t i = 0; i < n; ++i) ids[i] = static_cast<CourseCatalog::Id>(i);
+            CourseOrder order = static_cast<CourseOrder>(o);
+            std::sort(ids.begin(), ids.end(), [&](CourseCatalog::Id a, CourseCatalog::Id b) {
+                return catalog.order_less(order, a, b);
+            });
+            return ids;
+        }));
+    }
+    std::vector<std::vector<CourseCatalog::Id>> orders;
+    for (auto& job : jobs) orders.push_back(job.get());
+    catalog.set_orders(std::move(depth), std::move(orders));
+}
+
+// ------------------------------ Simulation -----------------------------------
+// Counter-based random numbers: the value depends only on (seed, student,
+// term, course, stream), so results do not depend on how work is split.
+static inline std::uint64_t counter_rng(std::uint64_t seed, std::uint64_t student, std::uint64_t term,
+                                        std::uint64_t course, std::uint64_t stream) {
+    std::uint64_t x = seed ^ (student * 0x9e3779b97f4a7c15ULL) ^ (term << 48) ^ (course << 8) ^ stream;
+    x += 0x9e3779b97f4a7c15ULL;  // splitmix64
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Largest cohort the REPL accepts; each student-term scans every course.
+constexpr std::uint32_t kMaxCohort = 1000000;
+
+struct SimulationConfig {
+    std::uint32_t students = 1000;
+    std::uint32_t terms = 8;
+    double pass_rate = 0.85;          // chance of passing a course taken
+    std::uint32_t courses_per_term = 4;
+    std::uint64_t seed = 1;
+};
+
+// demand[t * n + v] = students enrolled in course v during term t.
+struct SimulationResult {
+    std::vector<std::uint64_t> demand;
+    std::uint64_t student_terms = 0;
+};
+
+// Advances a synthetic cohort term by term. Each term a student takes up to
+// courses_per_term eligible courses (all prerequisites passed), picked at
+// random, and passes each with pass_rate. Students run in parallel chunks
+// with per-thread demand arrays that are summed at the end.
+SimulationResult simulate_enrollment(const PrereqGraph& g, const SimulationConfig& cfg) {
+    const size_t n = g.size();
+    const size_t words = (n + 63) / 64;
+
+    std::vector<std::vector<std::uint64_t>> partial(std::max<size_t>(1, std::thread::hardware_concurrency()));
+    size_t used = for_each_chunk(cfg.students, [&](size_t begin, size_t end, size_t chunk) {
+        std::vector<std::uint64_t>& demand = partial[chunk];
+        demand.assign(static_cast<size_t>(cfg.terms) * n, 0);
+        std::vector<std::uint64_t> passed(words);
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> eligible;
+        std::vector<std::uint32_t> newly_passed;
+
+        for (size_t student = begin; student < end; ++student) {
+            std::fill(passed.begin(), passed.end(), 0);
+            for (std::uint32_t term = 0; term < cfg.terms; ++term) {
+                eligible.clear();
+                for (std::uint32_t v = 0; v < n; ++v) {
+                    if (passed[v / 64] >> (v % 64) & 1) continue;
+                    bool ready = std::all_of(g.prereqs_begin(v), g.prereqs_end(v),
+                                             [&passed](std::uint32_t u) { return passed[u / 64] >> (u % 64) & 1; });
+                    if (ready) eligible.emplace_back(counter_rng(cfg.seed, student, term, v, 0), v);
+                }
+                size_t take = std::min<size_t>(cfg.courses_per_term, eligible.size());
+                std::partial_sort(eligible.begin(), eligible.begin() + take, eligible.end());
+
+                newly_passed.clear();
+                for (size_t i = 0; i < take; ++i) {
+                    std::uint32_t v = eligible[i].second;
+                    ++demand[static_cast<size_t>(term) * n + v];
+                    double roll = static_cast<double>(counter_rng(cfg.seed, student, term, v, 1) >> 11) * 0x1.0p-53;
+                    if (roll < cfg.pass_rate) newly_passed.push_back(v);  // roll is uniform in [0, 1)
+                }
+                for (std::uint32_t v : newly_passed) passed[v / 64] |= 1ULL << (v % 64);
+            }
+        }
+    }, 256);
+
+    SimulationResult result;
+    result.demand.assign(static_cast<size_t>(cfg.terms) * n, 0);
+    for (size_t c = 0; c < used; ++c) {
+        for (size_t i = 0; i < partial[c].size(); ++i) result.demand[i] += partial[c][i];
+    }
+    result.student_terms = static_cast<std::uint64_t>(cfg.students) * cfg.terms;
+    return result;
+}
+
+// ------------------------------- Centrality ----------------------------------
+// Structural importance of each course in the prerequisite graph.
+struct CentralityScores {
+    std::vector<std::uint32_t> downstream;  // courses that transitively require this one
+    std::vector<std::uint32_t> upstream;    // courses this one transitively requires
+    std::vector<double> pagerank;           // rank flows from a course to its prerequisites
+    std::vector<double> betweenness;        // sampled Brandes, scaled to the full graph
+};
+
+// Counts nodes reachable from each node along next(v), one BFS per node.
+template <typename Begin, typename End>
+static void reach_counts(const PrereqGraph& g, Begin begin_of, End end_of, std::vector<std::uint32_t>& out) {
+    const size_t n = g.size();
+    out.assign(n, 0);
+    for_each_chunk(n, [&](size_t begin, size_t end, size_t) {
+        std::vector<std::uint32_t> seen(n, UINT32_MAX), queue;
+        for (size_t src = begin; src < end; ++src) {
+            queue.assign(1, static_cast<std::uint32_t>(src));
+            seen[src] = static_cast<std::uint32_t>(src);
+            for (size_t head = 0; head < queue.size(); ++head) {
+                for (const std::uint32_t* p = begin_of(queue[head]); p != end_of(queue[head]); ++p) {
+                    if (seen[*p] != src) {
+                        seen[*p] = static_cast<std::uint32_t>(src);
+                        queue.push_back(*p);
+                    }
+                }
+            }
+            out[src] = static_cast<std::uint32_t>(queue.size() - 1);
+        }
+    }, 256);
+}
+
+CentralityScores compute_centrality(const PrereqGraph& g, size_t betweenness_samples = 256) {
+    const size_t n = g.size();
+    CentralityScores sc;
+    reach_counts(g, [&g](size_t v) { return g.dependents_begin(v); }, [&g](size_t v) { return g.dependents_end(v); },
+                 sc.downstream);
+    reach_counts(g, [&g](size_t v) { return g.prereqs_begin(v); }, [&g](size_t v) { return g.prereqs_end(v); },
+                 sc.upstream);
+
+    // PageRank, pull form: each course collects rank from the courses that list it
+    const double damping = 0.85;
+    sc.pagerank.assign(n, n ? 1.0 / static_cast<double>(n) : 0.0);
+    std::vector<double> next(n);
+    for (int iter = 0; iter < 30 && n; ++iter) {
+        double dangling = 0.0;
+        for (size_t v = 0; v < n; ++v) {
+            if (g.prereq_count(v) == 0) dangling += sc.pagerank[v];
+        }
+        double base = (1.0 - damping + damping * dangling) / static_cast<double>(n);
+        for_each_chunk(n, [&](size_t begin, size_t end, size_t) {
+            for (size_t u = begin; u < end; ++u) {
+                double sum = 0.0;
+                for (const std::uint32_t* w = g.dependents_begin(u); w != g.dependents_end(u); ++w) {
+                    sum += sc.pagerank[*w] / static_cast<double>(g.prereq_count(*w));
+                }
+                next[u] = base + damping * sum;
+            }
+        });
+        sc.pagerank.swap(next);
+    }
+
+    // Betweenness: Brandes from a fixed hash-chosen sample of sources,
+    // following prerequisite -> dependent edges, per-thread accumulators
+    std::vector<std::uint32_t> sources(n);
+    for (size_t v = 0; v < n; ++v) sources[v] = static_cast<std::uint32_t>(v);
+    size_t k = std::min(n, betweenness_samples);
+    std::partial_sort(sources.begin(), sources.begin() + k, sources.end(), [](std::uint32_t a, std::uint32_t b) {
+        return counter_rng(0, a, 0, 0, 2) < counter_rng(0, b, 0, 0, 2);
+    });
+    std::vector<std::vector<double>> partial(std::max<size_t>(1, std::thread::hardware_concurrency()));
+    size_t used = for_each_chunk(k, [&](size_t begin, size_t end, size_t chunk) {
+        std::vector<double>& acc = partial[chunk];
+        acc.assign(n, 0.0);
+        std::vector<double> sigma(n), delta(n);
+        std::vector<std::int32_t> dist(n, -1);
+        std::vector<std::uint32_t> order;
+        for (size_t i = begin; i < end; ++i) {
+            std::uint32_t s = sources[i];
+            order.assign(1, s);
+            dist[s] = 0;
+            sigma[s] = 1.0;
+            for (size_t head = 0; head < order.size(); ++head) {
+                std::uint32_t v = order[head];
+                for (const std::uint32_t* w = g.dependents_begin(v); w != g.dependents_end(v); ++w) {
+                    if (dist[*w] < 0) {
+                        dist[*w] = dist[v] + 1;
+                        order.push_back(*w);
+                    }
+                    if (dist[*w] == dist[v] + 1) sigma[*w] += sigma[v];
+                }
+            }
+            for (size_t j = order.size(); j-- > 0;) {
+                std::uint32_t w = order[j];
+                for (const std::uint32_t* v = g.prereqs_begin(w); v != g.prereqs_end(w); ++v) {
+                    if (dist[*v] >= 0 && dist[*v] == dist[w] - 1) delta[*v] += sigma[*v] / sigma[w] * (1.0 + delta[w]);
+                }
+                if (w != s) acc[w] += delta[w];
+            }
+            for (std::uint32_t v : order) {
+                dist[v] = -1;
+                sigma[v] = 0.0;
+                delta[v] = 0.0;
+            }
+        }
+    }, 8);
+    sc.betweenness.assign(n, 0.0);
+    double scale = k ? static_cast<double>(n) / static_cast<double>(k) : 0.0;
+    for (size_t c = 0; c < used; ++c) {
+        for (size_t v = 0; v < n; ++v) sc.betweenness[v] += partial[c][v] * scale;
+    }
+    return sc;
+}
+
+// --------------------------- Transitive reduction ----------------------------
+// A prerequisite link course -> prereq is redundant when another listed
+// prerequisite (via) already requires prereq, directly or transitively.
+struct RedundantPrereq {
+    std::uint32_t course;
+    std::uint32_t prereq;
+    std::uint32_t via;
+};
+
+struct ReductionResult {
+    std::vector<RedundantPrereq> redundant;
+    size_t links = 0;        // prerequisite links examined
+    size_t cyclic = 0;       // courses skipped because they sit on a prerequisite cycle
+};
+
+// Finds redundant links with ancestor bitsets. Closures are built one block
+// of kBlockBits target columns at a time, and each worker holds one block
+// (n * 512 bytes). Blocks run on separate threads, but only as many at once
+// as fit in kClosureBudget, so peak memory stays under
+// max(kClosureBudget, n * 512 bytes) whatever the thread count.
+ReductionResult find_redundant_prereqs(const PrereqGraph& g) {
+    constexpr size_t kBlockBits = 4096;
+    constexpr size_t kWords = kBlockBits / 64;
+    constexpr size_t kClosureBudget = size_t(1) << 30;
+    const size_t n = g.size();
+    ReductionResult result;
+    result.links = g.prereq_ids.size();
+
+    // Topological order, prerequisites first (Kahn); cycle members never appear
+    std::vector<std::uint32_t> order, pending(n);
+    for (size_t v = 0; v < n; ++v) {
+        pending[v] = static_cast<std::uint32_t>(g.prereq_count(v));
+        if (pending[v] == 0) order.push_back(static_cast<std::uint32_t>(v));
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        for (const std::uint32_t* w = g.dependents_begin(order[head]); w != g.dependents_end(order[head]); ++w) {
+            if (--pending[*w] == 0) order.push_back(*w);
+        }
+    }
+    result.cyclic = n - order.size();
+
+    const size_t blocks = (n + kBlockBits - 1) / kBlockBits;
+    const size_t block_bytes = std::max<size_t>(1, n * kWords * sizeof(std::uint64_t));
+    const size_t max_workers = std::max<size_t>(1, kClosureBudget / block_bytes);
+    std::vector<std::vector<RedundantPrereq>> found(blocks);
+    for_each_chunk(blocks, [&](size_t begin, size_t end, size_t) {
+        std::vector<std::uint64_t> anc;
+        for (size_t block = begin; block < end; ++block) {
+            const size_t lo = block * kBlockBits, hi = std::min(n, lo + kBlockBits);
+            anc.assign(n * kWords, 0);
+            for (std::uint32_t v : order) {
+                std::uint64_t* av = &anc[static_cast<size_t>(v) * kWords];
+                for (const std::uint32_t* u = g.prereqs_begin(v); u != g.prereqs_end(v); ++u) {
+                    const std::uint64_t* au = &anc[static_cast<size_t>(*u) * kWords];
+                    for (size_t k = 0; k < kWords; ++k) av[k] |= au[k];
+                    if (*u >= lo && *u < hi) av[(*u - lo) / 64] |= 1ULL << ((*u - lo) % 64);
+                }
+            }
+            for (std::uint32_t v : order) {
+                for (const std::uint32_t* u = g.prereqs_begin(v); u != g.prereqs_end(v); ++u) {
+                    if (*u < lo || *u >= hi) continue;
+                    size_t word = (*u - lo) / 64;
+                    std::uint64_t bit = 1ULL << ((*u - lo) % 64);
+                    for (const std::uint32_t* w = g.prereqs_begin(v); w != g.prereqs_end(v); ++w) {
+                        if (w != u && (anc[static_cast<size_t>(*w) * kWords + word] & bit)) {
+                            found[block].push_back({v, *u, *w});
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }, (blocks + max_workers - 1) / max_workers);  // chunk size that keeps at most max_workers threads
+
+    for (auto& part : found) result.redundant.insert(result.redundant.end(), part.begin(), part.end());
+    return result;
+}
+
+// ------------------------------- Top-k ---------------------------------------
+// Keeps the k best items seen so far in a heap whose top is the worst kept
+// item, so a stream of n items costs O(n log k) and O(k) memory.
+// better(a, b) is true when a ranks ahead of b.
+template <typename T, typename Better>
+class BoundedTopK {
+public:
+    // Callers clamp k to the number of candidates; the heap reserves k up front.
+    BoundedTopK(size_t k, Better better) : k_(k), better_(better) { heap_.reserve(k); }
+
+    void push(const T& item) {
+        if (k_ == 0) return;
+        if (heap_.size() < k_) {
+            heap_.push_back(item);
+            std::push_heap(heap_.begin(), heap_.end(), better_);
+        } else if (better_(item, heap_.front())) {
+            std::pop_heap(heap_.begin(), heap_.end(), better_);
+            heap_.back() = item;
+            std::push_heap(heap_.begin(), heap_.end(), better_);
+        }
+    }
+    void merge(const BoundedTopK& other) {
+        for (const T& item : other.heap_) push(item);
+    }
+    // Best first.
+    std::vector<T> sorted() const {
+        std::vector<T> out = heap_;
+        std::sort(out.begin(), out.end(), better_);
+        return out;
+    }
+
+private:
+    size_t k_;
+    Better better_;
+    std::vector<T> heap_;
+};
+
+enum class TopKQuery { MostDependents, DeepestChains, OrphanDepartments };
+
+// One ranked row: a course id (or department id for OrphanDepartments) and its score.
+struct TopKEntry {
+    std::uint32_t id = 0;
+    std::uint64_t score = 0;
+};
+
+// Answers a top-k query in one parallel pass: each chunk streams its ids
+// into its own bounded heap, and the per-chunk heaps are merged at the end.
+// Orphan courses (no prerequisites and no dependents) are first counted per
+// department in per-chunk arrays, then the department totals go through the
+// same heap. Courses on a prerequisite cycle have no depth and are skipped.
+// Requires the depth column from build_course_orders for DeepestChains.
+std::vector<TopKEntry> top_k(const CourseCatalog& catalog, const PrereqGraph& g, TopKQuery query, size_t k) {
+    const size_t n = catalog.size();
+    // More rows than exist cannot be returned; clamping keeps heap reservations bounded
+    k = std::min(k, query == TopKQuery::OrphanDepartments ? catalog.dept_count() : n);
+    auto course_better = [&catalog](const TopKEntry& a, const TopKEntry& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return catalog.course(a.id).number < catalog.course(b.id).number;
+    };
+    auto dept_better = [&catalog](const TopKEntry& a, const TopKEntry& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return catalog.dept_name(a.id) < catalog.dept_name(b.id);
+    };
+    const size_t slots = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+    if (query == TopKQuery::OrphanDepartments) {
+        const std::vector<std::uint32_t>& dept = catalog.dept_column();
+        std::vector<std::vector<std::uint64_t>> partial(slots);
+        size_t used = for_each_chunk(n, [&](size_t begin, size_t end, size_t chunk) {
+            std::vector<std::uint64_t>& counts = partial[chunk];
+            counts.assign(catalog.dept_count(), 0);
+            for (size_t v = begin; v < end; ++v) {
+                if (g.prereq_count(v) == 0 && g.dependent_count(v) == 0) ++counts[dept[v]];
+            }
+        });
+        BoundedTopK<TopKEntry, decltype(dept_better)> heap(k, dept_better);
+        for (size_t d = 0; d < catalog.dept_count(); ++d) {
+            TopKEntry e{static_cast<std::uint32_t>(d), 0};
+            for (size_t c = 0; c < used; ++c) e.score += partial[c][d];
+            if (e.score) heap.push(e);
+        }
+        return heap.sorted();
+    }
+
+    std::vector<BoundedTopK<TopKEntry, decltype(course_better)>> heaps(slots, {k, course_better});
+    size_t used = for_each_chunk(n, [&](size_t begin, size_t end, size_t chunk) {
+        auto& heap = heaps[chunk];
+        for (size_t v = begin; v < end; ++v) {
+            TopKEntry e{static_cast<std::uint32_t>(v), 0};
+            if (query == TopKQuery::MostDependents) {
+                e.score = g.dependent_count(v);
+            } else {
+                std::uint16_t depth = catalog.prereq_depth(e.id);
+                if (depth == UINT16_MAX) continue;
+                e.score = depth;
+            }
+            heap.push(e);
+        }
+    });
+    for (size_t c = 1; c < used; ++c) heaps[0].merge(heaps[c]);
+    return heaps[0].sorted();
+}
+
+// ------------------------------- Queries -------------------------------------
+// Small filter language over the catalog, e.g.
+//   dept = CSCI and level >= 300 and prereq_count = 0 and title contains "data"
+// A query compiles to a list of predicates; each one is applied a column at a
+// time to a selection vector of course ids.
+enum class CmpOp : std::uint8_t { Eq, Ne, Lt, Le, Gt, Ge, Contains };
+
+struct QueryPredicate {
+    enum class Field : std::uint8_t { Numeric, Dept, Number, Title } field;
+    NumericColumn column = kLevelCol;  // when field == Numeric
+    CmpOp op = CmpOp::Eq;
+    std::uint16_t value = 0;           // numeric operand
+    std::string text;                  // text operand (uppercased for Dept/Number)
+};
+
+// Splits a query into words, quoted strings and comparison operators.
+static std::vector<std::string> tokenize_query(const std::string& q) {
+    std::vector<std::string> tokens;
+    size_t i = 0;
+    while (i < q.size()) {
+        char ch = q[i];
+        if (std::isspace(static_cast<unsigned char>(ch))) {
+            ++i;
+        } else if (ch == '"') {
+            size_t end = q.find('"', i + 1);
+            if (end == std::string::npos) end = q.size();
+            tokens.push_back(q.substr(i, end - i));  // keeps the opening quote as a marker
+            i = end + 1;
+        } else if (ch == '=' || ch == '!' || ch == '<' || ch == '>') {
+            size_t len = (i + 1 < q.size() && q[i + 1] == '=') ? 2 : 1;
+            tokens.push_back(q.substr(i, len));
+            i += len;
+        } else {
+            size_t j = i;
+            while (j < q.size() && !std::isspace(static_cast<unsigned char>(q[j])) &&
+                   q[j] != '=' && q[j] != '!' && q[j] != '<' && q[j] != '>' && q[j] != '"') ++j;
+            tokens.push_back(q.substr(i, j - i));
+            i = j;
+        }
+    }
+    return tokens;
+}
+
+// Compiles a query into predicates, cheapest first.
+// Returns true on success; false with error message on a malformed query.
+bool compile_query(const std::string& query, std::vector<QueryPredicate>& plan, std::string& err) {
+    std::vector<std::string> tokens = tokenize_query(query);
+    plan.clear();
+    size_t i = 0;
+    while (i < tokens.size()) {
+        if (i + 3 > tokens.size()) {
+            err = "Incomplete condition near '" + tokens[i] + "'.";
+            return false;
+        }
+        std::string field = upper(tokens[i]);
+        std::string op = upper(tokens[i + 1]);
+        std::string value = tokens[i + 2];
+        bool quoted = !value.empty() && value[0] == '"';
+        if (quoted) value.erase(0, 1);
+
+        QueryPredicate p;
+        if (op == "=") p.op = CmpOp::Eq;
+        else if (op == "!=") p.op = CmpOp::Ne;
+        else if (op == "<") p.op = CmpOp::Lt;
+        else if (op == "<=") p.op = CmpOp::Le;
+        else if (op == ">") p.op = CmpOp::Gt;
+        else if (op == ">=") p.op = CmpOp::Ge;
+        else if (op == "CONTAINS") p.op = CmpOp::Contains;
+        else {
+            err = "Unknown operator '" + tokens[i + 1] + "'.";
+            return false;
+        }
+
+        bool text_field = true;
+        if (field == "DEPT") p.field = QueryPredicate::Field::Dept;
+        else if (field == "NUMBER") p.field = QueryPredicate::Field::Number;
+        else if (field == "TITLE") p.field = QueryPredicate::Field::Title;
+        else {
+            text_field = false;
+            p.field = QueryPredicate::Field::Numeric;
+            if (field == "LEVEL") p.column = kLevelCol;
+            else if (field == "PREREQ_COUNT") p.column = kPrereqCountCol;
+            else if (field == "CREDITS") p.column = kCreditsCol;
+            else if (field == "CAPACITY") p.column = kCapacityCol;
+            else {
+                err = "Unknown field '" + tokens[i] + "'.";
+                return false;
+            }
+        }
+
+        if (text_field) {
+            bool ordered = p.op != CmpOp::Eq && p.op != CmpOp::Ne && p.op != CmpOp::Contains;
+            if (ordered || (p.op == CmpOp::Contains && p.field == QueryPredicate::Field::Dept)) {
+                err = "Operator '" + tokens[i + 1] + "' does not apply to " + tokens[i] + ".";
+                return false;
+            }
+            p.text = (p.field == QueryPredicate::Field::Title) ? value : upper(value);
+        } else {
+            if (p.op == CmpOp::Contains || quoted || value.empty() || !parse_uint_field(std::string_view(value), p.value)) {
+                err = "Expected a number after '" + tokens[i] + " " + tokens[i + 1] + "'.";
+                return false;
+            }
+        }
+        plan.push_back(std::move(p));
+
+        i += 3;
+        if (i < tokens.size()) {
+            if (upper(tokens[i]) != "AND" || i + 1 == tokens.size()) {
+                err = "Expected 'and' between conditions.";
+                return false;
+            }
+            ++i;
+        }
+    }
+    if (plan.empty()) {
+        err = "Query is empty.";
+        return false;
+    }
+
+    // Integer column tests first, string tests last, so strings see fewer rows
+    std::stable_partition(plan.begin(), plan.end(), [](const QueryPredicate& p) {
+        return p.field == QueryPredicate::Field::Numeric || p.field == QueryPredicate::Field::Dept;
+    });
+    return true;
+}
+
+// Keeps the ids in sel whose column value passes keep(value); branch-free compaction.
+template <typename T, typename Keep>
+static void filter_column(const std::vector<T>& col, Keep keep, std::vector<CourseCatalog::Id>& sel) {
+    size_t out = 0;
+    for (size_t i = 0; i < sel.size(); ++i) {
+        CourseCatalog::Id id = sel[i];
+        sel[out] = id;
+        out += keep(col[id]) ? 1 : 0;
+    }
+    sel.resize(out);
+}
+
+template <typename T>
+static void filter_compare(const std::vector<T>& col, CmpOp op, T v, std::vector<CourseCatalog::Id>& sel) {
+    switch (op) {
+        case CmpOp::Eq: filter_column(col, [v](T x) { return x == v; }, sel); break;
+        case CmpOp::Ne: filter_column(col, [v](T x) { return x != v; }, sel); break;
+        case CmpOp::Lt: filter_column(col, [v](T x) { return x < v; }, sel); break;
+        case CmpOp::Le: filter_column(col, [v](T x) { return x <= v; }, sel); break;
+        case CmpOp::Gt: filter_column(col, [v](T x) { return x > v; }, sel); break;
+        case CmpOp::Ge: filter_column(col, [v](T x) { return x >= v; }, sel); break;
+        case CmpOp::Contains: break;
+    }
+}
+
+// Case-insensitive (ASCII) substring test.
+static bool contains_nocase(std::string_view hay, std::string_view needle) {
+    auto eq = [](char a, char b) {
+        return std::toupper(static_cast<unsigned char>(a)) == std::toupper(static_cast<unsigned char>(b));
+    };
+    return std::search(hay.begin(), hay.end(), needle.begin(), needle.end(), eq) != hay.end();
+}
+
+// Orders course ids by course number (the order option 2 lists them in).
+static void sort_by_number(const CourseCatalog& catalog, std::vector<CourseCatalog::Id>& ids) {
+    std::sort(ids.begin(), ids.end(), [&catalog](CourseCatalog::Id a, CourseCatalog::Id b) {
+        return catalog.course(a).number < catalog.course(b).number;
+    });
+}
+
+// Runs a compiled plan and returns the matching ids in course-number order.
+std::vector<CourseCatalog::Id> run_query(const CourseCatalog& catalog, const std::vector<QueryPredicate>& plan) {
+    std::vector<CourseCatalog::Id> sel(catalog.size());
+    for (size_t i = 0; i < sel.size(); ++i) sel[i] = static_cast<CourseCatalog::Id>(i);
+
+    for (const QueryPredicate& p : plan) {
+        if (sel.empty()) break;
+        switch (p.field) {
+            case QueryPredicate::Field::Numeric:
+                filter_compare(catalog.numeric_column(p.column), p.op, p.value, sel);
+                break;
+            case QueryPredicate::Field::Dept: {
+                std::uint32_t dept = 0;
+                if (!catalog.find_dept(p.text, dept)) {
+                    if (p.op == CmpOp::Eq) sel.clear();
+                    break;
+                }
+                filter_compare(catalog.dept_column(), p.op, dept, sel);
+                break;
+            }
+            case QueryPredicate::Field::Number:
+            case QueryPredicate::Field::Title: {
+                bool is_title = p.field == QueryPredicate::Field::Title;
+                size_t out = 0;
+                for (CourseCatalog::Id id : sel) {
+                    const Course& c = catalog.course(id);
+                    std::string_view v = is_title ? std::string_view(c.title) : std::string_view(c.number);
+                    bool hit = (p.op == CmpOp::Contains) ? contains_nocase(v, p.text) : CourseKeyEq()(v, p.text);
+                    if (hit == (p.op != CmpOp::Ne)) sel[out++] = id;
+                }
+                sel.resize(out);
+                break;
+            }
+        }
+    }
+
+    sort_by_number(catalog, sel);
+    return sel;
+}
+
+// ------------------------------- Diffing -------------------------------------
+// Differences between two catalogs, keyed by course number.
+struct CatalogDiff {
+    std::vector<CourseCatalog::Id> added;                                     // ids in the new catalog
+    std::vector<CourseCatalog::Id> removed;                                   // ids in the old catalog
+    std::vector<std::pair<CourseCatalog::Id, CourseCatalog::Id>> retitled;    // (old id, new id)
+    std::vector<std::pair<CourseCatalog::Id, CourseCatalog::Id>> prereqs_changed;
+};
+
+// Course ids ordered by course number.
+static std::vector<CourseCatalog::Id> ids_by_number(const CourseCatalog& catalog) {
+    std::vector<CourseCatalog::Id> ids(catalog.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = static_cast<CourseCatalog::Id>(i);
+    sort_by_number(catalog, ids);
+    return ids;
+}
+
+// Prerequisite lists compare as sets; listing order in the file is not a change.
+static bool same_prereqs(const Course& a, const Course& b) {
+    if (a.prereqs.size() != b.prereqs.size()) return false;
+    std::vector<std::string> x = a.prereqs, y = b.prereqs;
+    std::sort(x.begin(), x.end());
+    std::sort(y.begin(), y.end());
+    return x == y;
+}
+
+// Walks both catalogs in course-number order (a sorted merge) and collects changes.
+CatalogDiff diff_catalogs(const CourseCatalog& before, const CourseCatalog& after) {
+    CatalogDiff diff;
+    std::vector<CourseCatalog::Id> a = ids_by_number(before);
+    std::vector<CourseCatalog::Id> b = ids_by_number(after);
+    size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+        if (j == b.size() || (i < a.size() && before.course(a[i]).number < after.course(b[j]).number)) {
+            diff.removed.push_back(a[i++]);
+        } else if (i == a.size() || after.course(b[j]).number < before.course(a[i]).number) {
+            diff.added.push_back(b[j++]);
+        } else {
+            const Course& x = before.course(a[i]);
+            const Course& y = after.course(b[j]);
+            if (x.title != y.title) diff.retitled.emplace_back(a[i], b[j]);
+            if (!same_prereqs(x, y)) diff.prereqs_changed.emplace_back(a[i], b[j]);
+            ++i;
+            ++j;
+        }
+    }
+    return diff;
+}
+
 // ---------------------------- Presentation -----------------------------------
 void print_welcome() {
     std::cout << "Welcome to the course planner.\n\n";
@@ -137,31 +2602,301 @@ void print_menu() {
     std::cout << "  1. Load Data Structure.\n"
               << "  2. Print Course List.\n"
               << "  3. Print Course.\n"
-              << "  9. Exit\n\n"
+              << "  4. Search Courses.\n"
+              << "  5. Compare With Another File.\n"
+              << "  6. Load Sections.\n"
+              << "  7. Check Schedule.\n"
+              << "  8. Reserve or Release a Seat.\n"
+              << "  9. Exit\n"
+              << " 10. Simulate Enrollment.\n"
+              << " 11. Rank Gateway Courses.\n"
+              << " 12. Find Redundant Prerequisites.\n"
+              << " 13. Autocomplete.\n"
+              << " 14. Open File for Quick Lookups.\n"
+              << " 15. Open Sorted File (No Load).\n"
+              << " 16. Print Course List From File (Low Memory).\n"
+              << " 17. Print Course List In Another Order.\n"
+              << " 18. Top Courses and Departments.\n"
+              << " 19. Stress Test Seat Reservations.\n\n"
               << "What would you like to do? ";
 }
 
-// Prints the full, alphanumeric course list.
-void print_course_list(const CourseCatalog& catalog) {
-    auto numbers = catalog.sorted_numbers();
-    std::cout << "Here is a sample schedule:\n";
-    for (const auto& num : numbers) {
-        const Course* c = catalog.get(num);
-        if (c) std::cout << c->number << ", " << c->title << "\n";
+// Prints one "number, title" line of a course list.
+static inline void print_course_row(const Course& c) {
+    std::cout << c.number << ", " << c.title << "\n";
+}
+
+// Formats ids[begin, end) as course-list rows into one buffer.
+static std::string format_course_rows(const CourseCatalog& catalog, const std::vector<CourseCatalog::Id>& ids,
+                                      size_t begin, size_t end) {
+    std::string out;
+    for (size_t i = begin; i < end; ++i) {
+        const Course& c = catalog.course(ids[i]);
+        out += c.number;
+        out += ", ";
+        out += c.title;
+        out += '\n';
+    }
+    return out;
+}
+
+// Prints the course list in one of the precomputed orders (number order by default).
+// Large lists are formatted in fixed-size ranges on worker threads and
+// written in order as each range completes; at most two ranges per thread
+// are in flight, so memory stays bounded. Output matches the serial path.
+void print_course_list(const CourseCatalog& catalog, OpTimer* timer = nullptr, CourseOrder order = CourseOrder::Number) {
+    constexpr size_t kRangeRows = 16384;
+    std::vector<CourseCatalog::Id> sorted_ids;
+    if (!catalog.order_ready(order)) {
+        sorted_ids.resize(catalog.size());
+        for (size_t i = 0; i < sorted_ids.size(); ++i) sorted_ids[i] = static_cast<CourseCatalog::Id>(i);
+        std::sort(sorted_ids.begin(), sorted_ids.end(),
+                  [&](CourseCatalog::Id a, CourseCatalog::Id b) { return catalog.order_less(order, a, b); });
+    }
+    const std::vector<CourseCatalog::Id>& ids = catalog.order_ready(order) ? catalog.order(order) : sorted_ids;
+    if (timer) timer->phase("sort");
+    std::cout << "Here is a sample schedule:\n";
+
+    size_t threads = std::thread::hardware_concurrency();
+    if (threads < 2 || ids.size() <= kRangeRows) {
+        for (CourseCatalog::Id id : ids) print_course_row(catalog.course(id));
+    } else {
+        const size_t window = 2 * threads;
+        std::deque<std::future<std::string>> in_flight;
+        size_t next = 0;
+        while (next < ids.size() || !in_flight.empty()) {
+            while (next < ids.size() && in_flight.size() < window) {
+                size_t end = std::min(ids.size(), next + kRangeRows);
+                in_flight.push_back(std::async(std::launch::async, format_course_rows, std::cref(catalog),
+                                               std::cref(ids), next, end));
+                next = end;
+            }
+            std::cout << in_flight.front().get();
+            in_flight.pop_front();
+        }
+    }
+    std::cout << "\n";
+    if (timer) timer->phase("print");
+}
+
+// Runs a filter query and prints the matching courses in list form.
+void print_query_results(const CourseCatalog& catalog, const std::string& query, OpTimer* timer = nullptr) {
+    std::vector<QueryPredicate> plan;
+    std::string err;
+    if (!compile_query(query, plan, err)) {
+        std::cout << "Invalid query: " << err << "\n\n";
+        return;
+    }
+    if (timer) timer->phase("compile");
+    std::vector<CourseCatalog::Id> ids = run_query(catalog, plan);
+    if (timer) timer->phase("scan");
+
+    std::cout << ids.size() << (ids.size() == 1 ? " course matches" : " courses match") << ":\n";
+    for (CourseCatalog::Id id : ids) print_course_row(catalog.course(id));
+    std::cout << "\n";
+    if (timer) timer->phase("print");
+}
+
+// Joins a prerequisite list for display ("None" when empty).
+static std::string join_prereqs(const Course& c) {
+    if (c.prereqs.empty()) return "None";
+    std::string out;
+    for (size_t i = 0; i < c.prereqs.size(); ++i) {
+        if (i) out += ", ";
+        out += c.prereqs[i];
+    }
+    return out;
+}
+
+// Prints what changed between the loaded catalog and another one.
+void print_catalog_diff(const CourseCatalog& before, const CourseCatalog& after, OpTimer* timer = nullptr) {
+    CatalogDiff diff = diff_catalogs(before, after);
+    if (timer) timer->phase("merge");
+
+    for (CourseCatalog::Id id : diff.added) {
+        std::cout << "Added: ";
+        print_course_row(after.course(id));
+    }
+    for (CourseCatalog::Id id : diff.removed) {
+        std::cout << "Removed: ";
+        print_course_row(before.course(id));
+    }
+    for (const auto& ids : diff.retitled) {
+        std::cout << "Retitled: " << before.course(ids.first).number << ", " << before.course(ids.first).title
+                  << " -> " << after.course(ids.second).title << "\n";
+    }
+    for (const auto& ids : diff.prereqs_changed) {
+        std::cout << "Prerequisites changed: " << before.course(ids.first).number << ": "
+                  << join_prereqs(before.course(ids.first)) << " -> " << join_prereqs(after.course(ids.second)) << "\n";
+    }
+    std::cout << diff.added.size() << " added, " << diff.removed.size() << " removed, "
+              << diff.retitled.size() << " retitled, " << diff.prereqs_changed.size()
+              << " with changed prerequisites.\n\n";
+    if (timer) timer->phase("print");
+}
+
+// Splits a comma- or space-separated list typed at the prompt.
+static std::vector<std::string> split_list(const std::string& text) {
+    std::vector<std::string> items;
+    std::string item;
+    std::istringstream in(text);
+    while (in >> item) {
+        size_t start = 0;
+        while (start <= item.size()) {
+            size_t comma = item.find(',', start);
+            if (comma == std::string::npos) comma = item.size();
+            if (comma > start) items.push_back(item.substr(start, comma - start));
+            start = comma + 1;
+        }
+    }
+    return items;
+}
+
+// Prints the result of checking a candidate schedule.
+void print_schedule_check(const ScheduleCheck& check) {
+    for (const std::string& key : check.unknown) std::cout << key << " is not a known section.\n";
+    for (const auto& clash : check.clashes) {
+        std::cout << "Time conflict: " << clash.first->key << " overlaps " << clash.second->key << ".\n";
+    }
+    for (const auto& miss : check.missing_prereqs) {
+        std::cout << miss.first->key << " needs prerequisite " << miss.second << ".\n";
+    }
+    if (check.unknown.empty() && check.clashes.empty() && check.missing_prereqs.empty()) {
+        std::cout << "Schedule is valid: no time conflicts and all prerequisites met.\n";
+    }
+    std::cout << "\n";
+}
+
+// Prints the outcome of a seat ledger stress run.
+void print_seat_stress(const SeatStressResult& r) {
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(2);
+    out << "Ran " << r.ops << " claims and releases over " << r.sections << " sections on " << r.threads
+        << (r.threads == 1 ? " thread" : " threads") << " in " << r.ms << " ms (" << (r.ms > 0 ? r.ops / r.ms / 1000.0 : 0.0) << " million/s).\n";
+    out << "Claims: " << r.reserved << " reserved, " << r.waitlisted << " waitlisted, " << r.full << " full, "
+        << r.already_listed << " already listed, " << r.untracked << " untracked.\n";
+    out << "Releases: " << r.freed << " freed, " << r.passed_on << " passed to the waitlist, " << r.not_holding
+        << " held no seat.\n";
+    if (r.consistent) out << "Ledger consistent: no section oversubscribed and every seat has one holder.\n";
+    else out << "Ledger check FAILED: " << r.err << "\n";
+    std::cout << out.str() << "\n";
+}
+
+// Prints the busiest courses of each simulated term.
+void print_simulation(const CourseCatalog& catalog, const SimulationConfig& cfg, const SimulationResult& result,
+                      double elapsed_ms) {
+    const size_t n = catalog.size();
+    const size_t shown = 10;
+    for (std::uint32_t term = 0; term < cfg.terms; ++term) {
+        std::vector<std::pair<std::uint64_t, CourseCatalog::Id>> row;
+        for (size_t v = 0; v < n; ++v) {
+            std::uint64_t d = result.demand[static_cast<size_t>(term) * n + v];
+            if (d) row.emplace_back(d, static_cast<CourseCatalog::Id>(v));
+        }
+        size_t k = std::min(shown, row.size());
+        std::partial_sort(row.begin(), row.begin() + k, row.end(),
+                          [&catalog](const std::pair<std::uint64_t, CourseCatalog::Id>& a,
+                                     const std::pair<std::uint64_t, CourseCatalog::Id>& b) {
+                              if (a.first != b.first) return a.first > b.first;
+                              return catalog.course(a.second).number < catalog.course(b.second).number;
+                          });
+        std::cout << "Term " << (term + 1) << ":";
+        if (k == 0) std::cout << " no enrollments";
+        for (size_t i = 0; i < k; ++i) {
+            std::cout << (i ? ", " : " ") << catalog.course(row[i].second).number << " " << row[i].first;
+        }
+        std::cout << "\n";
+    }
+    std::cout << "Simulated " << result.student_terms << " student-terms in "
+              << static_cast<std::uint64_t>(elapsed_ms) << " ms.\n\n";
+}
+
+// Prints the top courses by betweenness, then downstream reach.
+void print_centrality(const CourseCatalog& catalog, const CentralityScores& sc, size_t shown = 15) {
+    std::vector<CourseCatalog::Id> ids(catalog.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = static_cast<CourseCatalog::Id>(i);
+    size_t k = std::min(shown, ids.size());
+    std::partial_sort(ids.begin(), ids.begin() + k, ids.end(), [&](CourseCatalog::Id a, CourseCatalog::Id b) {
+        if (sc.betweenness[a] != sc.betweenness[b]) return sc.betweenness[a] > sc.betweenness[b];
+        if (sc.downstream[a] != sc.downstream[b]) return sc.downstream[a] > sc.downstream[b];
+        return catalog.course(a).number < catalog.course(b).number;
+    });
+
+    std::ostringstream out;
+    out.precision(4);
+    out << "Course, downstream, upstream, PageRank, betweenness:\n";
+    for (size_t i = 0; i < k; ++i) {
+        CourseCatalog::Id id = ids[i];
+        out << (i + 1) << ". " << catalog.course(id).number << ", " << sc.downstream[id] << ", " << sc.upstream[id]
+            << ", " << sc.pagerank[id] << ", " << sc.betweenness[id] << "\n";
+    }
+    std::cout << out.str() << "\n";
+}
+
+// Prints a ranked top-k list with a heading for the query.
+void print_top_k(const CourseCatalog& catalog, TopKQuery query, const std::vector<TopKEntry>& rows) {
+    std::ostringstream out;
+    switch (query) {
+        case TopKQuery::MostDependents: out << "Courses with the most direct dependents:\n"; break;
+        case TopKQuery::DeepestChains: out << "Courses with the deepest prerequisite chains:\n"; break;
+        case TopKQuery::OrphanDepartments: out << "Departments with the most orphan courses:\n"; break;
+    }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const std::string& name = query == TopKQuery::OrphanDepartments ? catalog.dept_name(rows[i].id)
+                                                                         : catalog.course(rows[i].id).number;
+        out << (i + 1) << ". " << name << ", " << rows[i].score << "\n";
+    }
+    if (rows.empty()) out << "Nothing to rank.\n";
+    std::cout << out.str() << "\n";
+}
+
+// Lists redundant prerequisite links in course-number order.
+void print_redundant_prereqs(const CourseCatalog& catalog, ReductionResult& result) {
+    std::sort(result.redundant.begin(), result.redundant.end(), [&catalog](const RedundantPrereq& a, const RedundantPrereq& b) {
+        const std::string& x = catalog.course(a.course).number;
+        const std::string& y = catalog.course(b.course).number;
+        if (x != y) return x < y;
+        return catalog.course(a.prereq).number < catalog.course(b.prereq).number;
+    });
+    for (const RedundantPrereq& r : result.redundant) {
+        std::cout << catalog.course(r.course).number << ": " << catalog.course(r.prereq).number
+                  << " is already required by " << catalog.course(r.via).number << "\n";
     }
+    std::cout << result.redundant.size() << " of " << result.links << " prerequisite links are redundant.\n";
+    if (result.cyclic) std::cout << result.cyclic << " courses are on a prerequisite cycle and were skipped.\n";
     std::cout << "\n";
 }
 
+// Prints the typed header columns for a course, if the file provided any.
+void print_course_attributes(const Course& c) {
+    std::ostringstream oss;
+    const char* sep = "";
+    if (c.credits)  { oss << sep << "Credits: " << static_cast<unsigned>(c.credits); sep = " | "; }
+    if (c.level)    { oss << sep << "Level: " << c.level; sep = " | "; }
+    if (c.terms) {
+        static const char* const names[] = {"Fall", "Spring", "Summer", "Winter"};
+        oss << sep << "Terms: ";
+        const char* tsep = "";
+        for (unsigned b = 0; b < 4; ++b) {
+            if (c.terms & (1u << b)) { oss << tsep << names[b]; tsep = ", "; }
+        }
+        sep = " | ";
+    }
+    if (c.capacity) { oss << sep << "Capacity: " << c.capacity; }
+    if (!oss.str().empty()) std::cout << oss.str() << "\n";
+}
+
 // Prints a single course's title + prerequisites.
-void print_course_details(const CourseCatalog& catalog, const std::string& user_input_number) {
-    std::string number = upper(user_input_number);
-    const Course* c = catalog.get(number);
+// (Prerequisites are stored uppercased, so they print as the catalog keys.)
+void print_course_details(const Course* c, const std::string& user_input_number) {
     if (!c) {
-        std::cout << number << " was not found.\n\n";
+        std::cout << upper(user_input_number) << " was not found.\n\n";
         return;
     }
 
     std::cout << c->number << ", " << c->title << "\n";
+    print_course_attributes(*c);
 
     if (c->prereqs.empty()) {
         std::cout << "Prerequisites: None\n\n";
@@ -170,20 +2905,56 @@ void print_course_details(const CourseCatalog& catalog, const std::string& user_
 
     std::cout << "Prerequisites: ";
     for (size_t i = 0; i < c->prereqs.size(); ++i) {
-        const std::string& pnum = c->prereqs[i];
-        const Course* pc = catalog.get(pnum);
-        if (pc) std::cout << pc->number;
-        else    std::cout << pnum;
+        std::cout << c->prereqs[i];
         if (i + 1 < c->prereqs.size()) std::cout << ", ";
     }
     std::cout << "\n\n";
 }
 
+void print_course_details(const CourseCatalog& catalog, const std::string& user_input_number,
+                          OpTimer* timer = nullptr) {
+    const Course* c = catalog.get(user_input_number);
+    if (timer) timer->phase("lookup");
+    print_course_details(c, user_input_number);
+}
+
+// Same, binary-searching a pre-sorted file.
+void print_course_details(SortedCsvFile& sorted, const std::string& user_input_number, OpTimer* timer = nullptr) {
+    std::string err;
+    Course c;
+    bool found = sorted.find(user_input_number, c, err);
+    if (timer) timer->phase("search");
+    if (!err.empty()) {
+        std::cout << "Error: " << err << "\n\n";
+        return;
+    }
+    print_course_details(found ? &c : nullptr, user_input_number);
+}
+
+// Same, reading the row on demand from a lazily opened file.
+void print_course_details(LazyCatalog& lazy, const std::string& user_input_number, OpTimer* timer = nullptr) {
+    std::string err;
+    const Course* c = lazy.get(user_input_number, err);
+    if (timer) timer->phase("lookup");
+    if (!err.empty()) {
+        std::cout << "Error: " << err << "\n\n";
+        return;
+    }
+    print_course_details(c, user_input_number);
+}
+
 // ------------------------------- Main ----------------------------------------
 int main() {
     CourseCatalog catalog;
+    LazyCatalog lazy;                   // option 3 falls back to one of these when nothing is loaded
+    SortedCsvFile sorted_file;
+    std::uint64_t catalog_version = 0;  // bumped on every successful load
     bool running = true;
 
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, on_dump_signal);  // kill -USR1 <pid> dumps the slow-query log
+#endif
+
     print_welcome();
 
     while (running) {
@@ -198,7 +2969,7 @@ int main() {
             continue;
         }
 
-        // Accept single-digit numeric input; treat others as invalid.
+        // Accept one- or two-digit numeric input; treat others as invalid.
         if (option_raw.size() > 2) {
             std::cout << option_raw << " is not a valid option.\n\n";
             continue;
@@ -229,10 +3000,18 @@ int main() {
 
                 std::string err;
                 CourseCatalog newCatalog;
-                if (load_catalog_from_csv(filename, newCatalog, err)) {
+                OpTimer timer("load", filename, catalog_version);
+                if (load_catalog_from_csv(filename, newCatalog, err, &timer)) {
                     catalog = std::move(newCatalog);
+                    ++catalog_version;
                     std::cout << "Data loaded successfully (" 
-                              << catalog.sorted_numbers().size() << " courses).\n\n";
+                              << catalog.size() << " courses).\n";
+                    const BlockedBloom& filter = catalog.lookup_filter();
+                    std::ostringstream rate;
+                    rate.precision(2);
+                    rate << std::fixed << filter.false_positive_rate() * 100.0;
+                    std::cout << "Lookup filter: " << (filter.bytes() + 1023) / 1024 << " KiB, "
+                              << rate.str() << "% expected false positives.\n\n";
                 } else {
                     std::cout << "Error: " << err << "\n\n";
                 }
@@ -243,13 +3022,14 @@ int main() {
                 if (catalog.empty()) {
                     std::cout << "Please load the data structure first (option 1).\n\n";
                 } else {
-                    print_course_list(catalog);
+                    OpTimer timer("list", "", catalog_version);
+                    print_course_list(catalog, &timer);
                 }
                 break;
             }
 
             case 3: { // Print Course Details
-                if (catalog.empty()) {
+                if (catalog.empty() && !lazy.is_open() && !sorted_file.is_open()) {
                     std::cout << "Please load the data structure first (option 1).\n\n";
                 } else {
                     std::cout << "What course do you want to know about? ";
@@ -263,7 +3043,206 @@ int main() {
                         std::cout << "Course number cannot be empty.\n\n";
                         break;
                     }
-                    print_course_details(catalog, number);
+                    OpTimer timer("details", number, catalog_version);
+                    if (!catalog.empty())    print_course_details(catalog, number, &timer);
+                    else if (lazy.is_open()) print_course_details(lazy, number, &timer);
+                    else                     print_course_details(sorted_file, number, &timer);
+                }
+                break;
+            }
+
+            case 4: { // Search Courses
+                if (catalog.empty()) {
+                    std::cout << "Please load the data structure first (option 1).\n\n";
+                } else {
+                    std::cout << "Enter a query (e.g., dept = CSCI and level >= 300 and title contains \"data\"): ";
+                    std::string query;
+                    if (!std::getline(std::cin, query)) {
+                        std::cout << "Input cancelled.\n\n";
+                        break;
+                    }
+                    query = trim(query);
+                    if (query.empty()) {
+                        std::cout << "Query cannot be empty.\n\n";
+                        break;
+                    }
+                    OpTimer timer("search", query, catalog_version);
+                    print_query_results(catalog, query, &timer);
+                }
+                break;
+            }
+
+            case 5: { // Compare With Another File
+                if (catalog.empty()) {
+                    std::cout << "Please load the data structure first (option 1).\n\n";
+                    break;
+                }
+                std::cout << "Enter the file name to compare against: ";
+                std::string filename;
+                if (!std::getline(std::cin, filename)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                filename = trim(filename);
+                if (filename.empty()) {
+                    std::cout << "File name cannot be empty.\n\n";
+                    break;
+                }
+
+                std::string err;
+                CourseCatalog other;
+                OpTimer timer("diff", filename, catalog_version);
+                if (load_catalog_from_csv(filename, other, err, &timer)) {
+                    print_catalog_diff(catalog, other, &timer);
+                } else {
+                    std::cout << "Error: " << err << "\n\n";
+                }
+                break;
+            }
+
+            case 6: { // Load Sections
+                if (catalog.empty()) {
+                    std::cout << "Please load the data structure first (option 1).\n\n";
+                    break;
+                }
+                std::cout << "Enter the sections file name: ";
+                std::string filename;
+                if (!std::getline(std::cin, filename)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                filename = trim(filename);
+                if (filename.empty()) {
+                    std::cout << "File name cannot be empty.\n\n";
+                    break;
+                }
+
+                std::string err;
+                OpTimer timer("sections", filename, catalog_version);
+                if (load_sections_from_csv(filename, catalog, err)) {
+                    std::cout << "Sections loaded successfully (" << catalog.sections().size() << " sections).\n\n";
+                } else {
+                    std::cout << "Error: " << err << "\n\n";
+                }
+                break;
+            }
+
+            case 7: { // Check Schedule
+                if (catalog.sections().empty()) {
+                    std::cout << "Please load sections first (option 6).\n\n";
+                    break;
+                }
+                std::string completed, wanted;
+                std::cout << "Enter completed courses (blank for none): ";
+                if (!std::getline(std::cin, completed)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                std::cout << "Enter sections to take (e.g., CSCI200-01, MATH201-02): ";
+                if (!std::getline(std::cin, wanted)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                std::vector<std::string> keys = split_list(wanted);
+                if (keys.empty()) {
+                    std::cout << "Enter at least one section.\n\n";
+                    break;
+                }
+                OpTimer timer("schedule", trim(wanted), catalog_version);
+                ScheduleCheck check = check_schedule(catalog, keys, split_list(completed));
+                timer.phase("check");
+                print_schedule_check(check);
+                break;
+            }
+
+            case 8: { // Reserve or Release a Seat
+                if (catalog.sections().empty()) {
+                    std::cout << "Please load sections first (option 6).\n\n";
+                    break;
+                }
+                std::string student_raw, key, action;
+                std::cout << "Enter the student id: ";
+                if (!std::getline(std::cin, student_raw)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                std::uint32_t student = 0;
+                student_raw = trim(student_raw);
+                if (student_raw.empty() || !parse_uint_field(std::string_view(student_raw), student)) {
+                    std::cout << "Student id must be a number.\n\n";
+                    break;
+                }
+                std::cout << "Enter the section (e.g., CSCI200-01): ";
+                if (!std::getline(std::cin, key)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                const Section* section = catalog.find_section(trim(key));
+                if (!section) {
+                    std::cout << upper(trim(key)) << " is not a known section.\n\n";
+                    break;
+                }
+                std::cout << "Reserve or release (r/x)? ";
+                if (!std::getline(std::cin, action)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                action = upper(trim(action));
+                size_t idx = catalog.section_index(*section);
+                SeatLedger& ledger = catalog.seat_ledger();
+
+                if (action == "X") {
+                    std::uint32_t next = 0;
+                    switch (ledger.release(idx, student, next)) {
+                        case SeatLedger::Release::NotHolding:
+                            std::cout << "Student " << student << " holds no seat in " << section->key << ".\n\n";
+                            break;
+                        case SeatLedger::Release::PassedOn:
+                            std::cout << "Seat released; student " << next << " moved up from the waitlist.\n\n";
+                            break;
+                        case SeatLedger::Release::Freed:
+                            std::cout << "Seat released (" << ledger.taken(idx) << "/" << ledger.capacity(idx)
+                                      << " taken).\n\n";
+                            break;
+                    }
+                    break;
+                }
+                if (action != "R") {
+                    std::cout << action << " is not a valid choice.\n\n";
+                    break;
+                }
+
+                std::string completed;
+                std::cout << "Enter completed courses (blank for none): ";
+                if (!std::getline(std::cin, completed)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                std::vector<std::string> missing = unmet_prereqs(catalog.course(section->course), split_list(completed));
+                if (!missing.empty()) {
+                    std::cout << section->key << " needs prerequisite";
+                    for (size_t i = 0; i < missing.size(); ++i) std::cout << (i ? ", " : " ") << missing[i];
+                    std::cout << ".\n\n";
+                    break;
+                }
+                switch (ledger.claim(idx, student)) {
+                    case SeatLedger::Claim::Reserved:
+                        std::cout << "Seat reserved in " << section->key << " (" << ledger.taken(idx) << "/"
+                                  << ledger.capacity(idx) << " taken).\n\n";
+                        break;
+                    case SeatLedger::Claim::Waitlisted:
+                        std::cout << section->key << " is full; student " << student << " added to the waitlist.\n\n";
+                        break;
+                    case SeatLedger::Claim::Full:
+                        std::cout << section->key << " and its waitlist are full.\n\n";
+                        break;
+                    case SeatLedger::Claim::Untracked:
+                        std::cout << "The seat ledger has no room to track this claim right now; please try again.\n\n";
+                        break;
+                    case SeatLedger::Claim::AlreadyListed:
+                        std::cout << "Student " << student << " already has a seat or waitlist place in "
+                                  << section->key << ".\n\n";
+                        break;
                 }
                 break;
             }
@@ -274,10 +3253,282 @@ int main() {
                 break;
             }
 
+            case 10: { // Simulate Enrollment
+                if (catalog.empty()) {
+                    std::cout << "Please load the data structure first (option 1).\n\n";
+                    break;
+                }
+                std::cout << "Enter cohort size, terms, pass rate %, courses per term and seed (e.g., 10000 8 85 4 1): ";
+                std::string line;
+                if (!std::getline(std::cin, line)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                SimulationConfig cfg;
+                long long students = 0, terms = 0, per_term = 0;
+                double pass_pct = 0;
+                std::istringstream in(line);
+                if (!(in >> students >> terms >> pass_pct >> per_term >> cfg.seed) || students < 1 ||
+                    students > kMaxCohort || terms < 1 || terms > 64 || pass_pct < 0 || pass_pct > 100 || per_term < 0 ||
+                    per_term > 1000) {
+                    std::cout << "Please enter five numbers: students (1-" << kMaxCohort
+                              << "), terms (1-64), pass rate (0-100), courses per term (0-1000), seed.\n\n";
+                    break;
+                }
+                cfg.students = static_cast<std::uint32_t>(students);
+                cfg.terms = static_cast<std::uint32_t>(terms);
+                cfg.courses_per_term = static_cast<std::uint32_t>(per_term);
+                cfg.pass_rate = pass_pct / 100.0;
+
+                OpTimer timer("simulate", trim(line), catalog_version);
+                auto start = std::chrono::steady_clock::now();
+                PrereqGraph graph = build_prereq_graph(catalog);
+                timer.phase("graph");
+                SimulationResult result = simulate_enrollment(graph, cfg);
+                timer.phase("simulate");
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                print_simulation(catalog, cfg, result, ms);
+                break;
+            }
+
+            case 11: { // Rank Gateway Courses
+                if (catalog.empty()) {
+                    std::cout << "Please load the data structure first (option 1).\n\n";
+                    break;
+                }
+                OpTimer timer("centrality", "", catalog_version);
+                PrereqGraph graph = build_prereq_graph(catalog);
+                timer.phase("graph");
+                CentralityScores scores = compute_centrality(graph);
+                timer.phase("scores");
+                print_centrality(catalog, scores);
+                break;
+            }
+
+            case 12: { // Find Redundant Prerequisites
+                if (catalog.empty()) {
+                    std::cout << "Please load the data structure first (option 1).\n\n";
+                    break;
+                }
+                OpTimer timer("reduction", "", catalog_version);
+                PrereqGraph graph = build_prereq_graph(catalog);
+                timer.phase("graph");
+                ReductionResult result = find_redundant_prereqs(graph);
+                timer.phase("closure");
+                print_redundant_prereqs(catalog, result);
+                break;
+            }
+
+            case 13: { // Autocomplete
+                if (catalog.empty() && !sorted_file.is_open()) {
+                    std::cout << "Please load the data structure first (option 1).\n\n";
+                    break;
+                }
+                std::cout << (catalog.empty() ? "Start typing a course number: "
+                                              : "Start typing a course number or title word: ");
+                std::string prefix;
+                if (!std::getline(std::cin, prefix)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                prefix = trim(prefix);
+                OpTimer timer("complete", prefix, catalog_version);
+                if (catalog.empty()) {
+                    // Sorted file: course-number prefixes only, straight from the file
+                    std::string err;
+                    std::vector<Course> rows = sorted_file.with_prefix(prefix, Autocomplete::kTopK, err);
+                    for (const Course& c : rows) print_course_row(c);
+                    if (!err.empty()) std::cout << "Error: " << err << "\n";
+                    else if (rows.empty()) std::cout << "No matches for \"" << prefix << "\".\n";
+                    std::cout << "\n";
+                    break;
+                }
+                if (!catalog.completions_ready()) catalog.build_completions();
+                std::vector<CourseCatalog::Id> ids = catalog.complete(prefix);
+                if (ids.empty()) {
+                    std::cout << "No matches for \"" << prefix << "\".\n\n";
+                    break;
+                }
+                for (CourseCatalog::Id id : ids) print_course_row(catalog.course(id));
+                std::cout << "\n";
+                break;
+            }
+
+            case 14: { // Open File for Quick Lookups
+                std::cout << "Enter the file name to open for lookups: ";
+                std::string filename;
+                if (!std::getline(std::cin, filename)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                filename = trim(filename);
+                if (filename.empty()) {
+                    std::cout << "File name cannot be empty.\n\n";
+                    break;
+                }
+
+                std::string err;
+                OpTimer timer("open", filename, catalog_version);
+                // Open into a temporary so a bad file name leaves the current mode open
+                LazyCatalog opened;
+                if (opened.open(filename, err)) {
+                    sorted_file.close();
+                    lazy = std::move(opened);
+                    std::cout << "Indexed " << lazy.size() << " courses; rows are read on first lookup.\n";
+                    if (!catalog.empty()) std::cout << "Option 3 will keep using the data loaded with option 1.\n";
+                    std::cout << "\n";
+                } else {
+                    std::cout << "Error: " << err << "\n\n";
+                }
+                break;
+            }
+
+            case 15: { // Open Sorted File (No Load)
+                std::cout << "Enter the name of a file sorted by course number: ";
+                std::string filename;
+                if (!std::getline(std::cin, filename)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                filename = trim(filename);
+                if (filename.empty()) {
+                    std::cout << "File name cannot be empty.\n\n";
+                    break;
+                }
+
+                std::string err;
+                SortedCsvFile opened;  // swapped in only on success, as option 14 does
+                if (opened.open(filename, err)) {
+                    lazy.close();
+                    sorted_file = std::move(opened);
+                    std::cout << "Opened " << filename << "; options 3 and 13 search it directly.\n";
+                    if (!catalog.empty()) std::cout << "Option 3 will keep using the data loaded with option 1.\n";
+                    std::cout << "\n";
+                } else {
+                    std::cout << "Error: " << err << "\n\n";
+                }
+                break;
+            }
+
+            case 16: { // Print Course List From File (Low Memory)
+                std::cout << "Enter the file name to list: ";
+                std::string filename;
+                if (!std::getline(std::cin, filename)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                filename = trim(filename);
+                if (filename.empty()) {
+                    std::cout << "File name cannot be empty.\n\n";
+                    break;
+                }
+
+                std::string err;
+                OpTimer timer("external_list", filename, catalog_version);
+                if (!print_course_list_external(filename, err)) std::cout << "Error: " << err << "\n\n";
+                break;
+            }
+
+            case 17: { // Print Course List In Another Order
+                if (catalog.empty()) {
+                    std::cout << "Please load the data structure first (option 1).\n\n";
+                    break;
+                }
+                std::cout << "Order by 1) title, 2) department and level, 3) prerequisite depth: ";
+                std::string choice;
+                if (!std::getline(std::cin, choice)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                choice = trim(choice);
+                CourseOrder order;
+                if (choice == "1") order = CourseOrder::Title;
+                else if (choice == "2") order = CourseOrder::DeptLevel;
+                else if (choice == "3") order = CourseOrder::Depth;
+                else {
+                    std::cout << choice << " is not a valid order.\n\n";
+                    break;
+                }
+                OpTimer timer("list", choice, catalog_version);
+                if (!catalog.order_ready(order)) build_course_orders(catalog);  // depth is dropped by upserts
+                print_course_list(catalog, &timer, order);
+                break;
+            }
+
+            case 18: { // Top Courses and Departments
+                if (catalog.empty()) {
+                    std::cout << "Please load the data structure first (option 1).\n\n";
+                    break;
+                }
+                std::cout << "Rank 1) most direct dependents, 2) deepest prerequisite chains, "
+                             "3) departments with most orphan courses: ";
+                std::string choice;
+                if (!std::getline(std::cin, choice)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                choice = trim(choice);
+                TopKQuery query;
+                if (choice == "1") query = TopKQuery::MostDependents;
+                else if (choice == "2") query = TopKQuery::DeepestChains;
+                else if (choice == "3") query = TopKQuery::OrphanDepartments;
+                else {
+                    std::cout << choice << " is not a valid ranking.\n\n";
+                    break;
+                }
+                std::cout << "How many (default 20)? ";
+                std::string count_text;
+                if (!std::getline(std::cin, count_text)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                count_text = trim(count_text);
+                std::uint32_t k = 20;
+                if (!count_text.empty() && !parse_uint_field(std::string_view(count_text), k)) {
+                    std::cout << count_text << " is not a valid count.\n\n";
+                    break;
+                }
+                OpTimer timer("top-k", choice, catalog_version);
+                if (query == TopKQuery::DeepestChains && !catalog.order_ready(CourseOrder::Depth)) {
+                    build_course_orders(catalog);  // depth is dropped by upserts
+                }
+                PrereqGraph graph = build_prereq_graph(catalog);
+                timer.phase("graph");
+                std::vector<TopKEntry> rows = top_k(catalog, graph, query, k);
+                timer.phase("rank");
+                print_top_k(catalog, query, rows);
+                break;
+            }
+
+            case 19: { // Stress Test Seat Reservations
+                if (catalog.sections().empty()) {
+                    std::cout << "Please load sections first (option 6).\n\n";
+                    break;
+                }
+                std::cout << "How many claims and releases (default 4000000)? ";
+                std::string count_text;
+                if (!std::getline(std::cin, count_text)) {
+                    std::cout << "Input cancelled.\n\n";
+                    break;
+                }
+                count_text = trim(count_text);
+                std::uint32_t ops = 4000000;
+                if (!count_text.empty() && !parse_uint_field(std::string_view(count_text), ops)) {
+                    std::cout << count_text << " is not a valid count.\n\n";
+                    break;
+                }
+                OpTimer timer("seat-stress", count_text, catalog_version);
+                SeatStressResult result = stress_seat_ledger(catalog.sections(), ops);
+                timer.phase("stress");
+                print_seat_stress(result);
+                break;
+            }
+
             default:
                 std::cout << option << " is not a valid option.\n\n";
         }
     }
 
+    dump_slow_log();
     return 0;
 }